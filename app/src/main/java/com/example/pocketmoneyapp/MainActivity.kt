@@ -16,6 +16,9 @@ import androidx.activity.result.contract.ActivityResultContracts
 import androidx.appcompat.app.AppCompatActivity
 import androidx.recyclerview.widget.LinearLayoutManager
 import androidx.recyclerview.widget.RecyclerView
+import com.example.pocketmoneyapp.data.LatencyStatDto
+import com.example.pocketmoneyapp.data.PageCacheStatsDto
+import com.example.pocketmoneyapp.data.SlowQueryDto
 import com.example.pocketmoneyapp.data.WalletDto
 import com.example.pocketmoneyapp.ui.WalletAdapter
 import com.google.android.material.floatingactionbutton.FloatingActionButton // FAB import
@@ -27,6 +30,7 @@ class MainActivity : AppCompatActivity() {
     private val walletList = mutableListOf<WalletDto>()
     private lateinit var noWalletsTextView: TextView // Empty State TextView
     private lateinit var addWalletFab: FloatingActionButton // FAB
+    private var loadedWalletGeneration = 0L // 마지막으로 목록을 읽은 지갑 캐시 세대 (0 이면 아직 안 읽음)
 
     private external fun initializeNativeDb(dbPath: String)
     private external fun createWalletNative(name: String, description: String, balance: Long): Boolean
@@ -34,6 +38,15 @@ class MainActivity : AppCompatActivity() {
     private external fun updateWalletNative(id: Int, name: String, description: String, balance: Long): Boolean
     private external fun deleteWalletNative(id: Int): Boolean
     private external fun getWalletByIdNative(id: Int): WalletDto? // 변경된 부분: 널러블 반환 타입
+    private external fun snapshotLatencyNative(reset: Boolean): Array<LatencyStatDto> // 연산별 지연 분포 (reset 이면 비움)
+    private external fun setNativeLogLevelNative(level: Int) // android.util.Log.DEBUG..ERROR
+    private external fun setSlowQueryLogNative(capacity: Int, thresholdMicros: Long): Boolean // capacity 0 이면 끔
+    private external fun dumpSlowQueriesNative(reset: Boolean): Array<SlowQueryDto> // 느린 순
+    private external fun rebuildMonthlyTotalsNative(): Boolean // 월별 합계를 거래 전체에서 다시 계산
+    private external fun getWalletGenerationNative(): Long // 지갑이 바뀔 때마다 오르는 세대
+    private external fun walletsChangedSinceNative(generation: Long): Boolean
+    private external fun setPageCacheBudgetNative(budgetBytes: Long) // 거래 목록 페이지 캐시 예산 (0 이면 끔)
+    private external fun getPageCacheStatsNative(reset: Boolean): PageCacheStatsDto? // 적중/실패 횟수
 
     // 트랜잭션 목록 액티비티에서 돌아올 때 결과 처리를 위한 런처
     private val transactionListActivityResultLauncher = registerForActivityResult(
@@ -99,10 +112,15 @@ class MainActivity : AppCompatActivity() {
 
     override fun onResume() {
         super.onResume()
-        loadWallets() // 앱이 다시 활성화될 때마다 지갑 목록 갱신 (잔액 반영 위함)
+        // 앱이 다시 활성화될 때 지갑이나 잔액이 바뀐 경우에만 목록 갱신
+        if (loadedWalletGeneration == 0L || walletsChangedSinceNative(loadedWalletGeneration)) {
+            loadWallets()
+        }
     }
 
     private fun loadWallets() {
+        // 목록보다 먼저 읽어야 그 사이 변경이 다음 onResume 에서 다시 읽힌다
+        loadedWalletGeneration = getWalletGenerationNative()
         val walletsArray = getAllWalletsNative()
         walletList.clear()
         walletList.addAll(walletsArray.toList())
@@ -15,7 +15,13 @@ import android.widget.Toast
 import androidx.appcompat.app.AppCompatActivity
 import androidx.recyclerview.widget.LinearLayoutManager
 import androidx.recyclerview.widget.RecyclerView
+import com.example.pocketmoneyapp.data.CsvImportProgressListener
+import com.example.pocketmoneyapp.data.CsvImportResultDto
+import com.example.pocketmoneyapp.data.MonthlyTotalDto
+import com.example.pocketmoneyapp.data.TransactionExportProgressListener
 import com.example.pocketmoneyapp.data.TransactionDto
+import com.example.pocketmoneyapp.data.TransactionPageDto
+import com.example.pocketmoneyapp.data.TransactionSearchPageDto
 import com.example.pocketmoneyapp.ui.TransactionAdapter
 import com.example.pocketmoneyapp.data.TransactionType
 import com.google.android.material.floatingactionbutton.FloatingActionButton // FAB import
@@ -46,8 +52,64 @@ class TransactionListActivity : AppCompatActivity() {
         transactionDate: String
     ): Boolean
 
+    // 같은 인덱스끼리 한 건. 전체가 하나의 트랜잭션으로 처리되며 삽입된 건수를 반환한다 (실패 시 0).
+    private external fun createTransactionsNative(
+        walletIds: IntArray,
+        descriptions: Array<String>,
+        amounts: LongArray,
+        types: IntArray,
+        transactionDates: Array<String>
+    ): Int
+
+    // 은행 내보내기 CSV(UTF-8)를 스트리밍으로 가져온다. 파일 크기와 무관하게 메모리가 일정하다.
+    // fd 는 닫지 않으며 (ParcelFileDescriptor.fd), walletId 가 0 이면 파일의 wallet_id 열을 쓴다.
+    // 끝날 때까지 막히므로 메인 스레드가 아닌 곳에서 호출한다.
+    private external fun importTransactionsCsvNative(
+        fd: Int,
+        walletId: Int,
+        listener: CsvImportProgressListener?
+    ): CsvImportResultDto?
+
+    // 거래를 fd 로 스트리밍해 내보낸다. format 0 = CSV (다시 가져오기 가능), 1 = JSON Lines.
+    // walletId 가 0 이면 모든 지갑을 ID 순으로, 아니면 그 지갑을 날짜순으로 쓴다. fd 는 닫지 않는다.
+    // 쓴 행 수를 반환하고 실패하거나 취소되면 -1. 메인 스레드가 아닌 곳에서 호출한다.
+    private external fun exportTransactionsNative(
+        fd: Int,
+        walletId: Int,
+        format: Int,
+        listener: TransactionExportProgressListener?
+    ): Long
+
     private external fun getTransactionsByWalletNative(walletId: Int): Array<TransactionDto>
 
+    // afterDate 가 null 이면 첫 페이지, 이후에는 이전 페이지의 nextDate/nextId 를 넘긴다.
+    private external fun getTransactionsPageNative(
+        walletId: Int,
+        afterDate: String?,
+        afterId: Int,
+        limit: Int
+    ): TransactionPageDto?
+
+    // 설명 전문 검색. walletId 가 0 이면 모든 지갑, afterId 가 0 이면 첫 페이지이고
+    // 이후에는 이전 페이지의 nextRank/nextId 를 넘긴다.
+    private external fun searchTransactionsNative(
+        query: String,
+        walletId: Int,
+        limit: Int,
+        afterRank: Double,
+        afterId: Int
+    ): TransactionSearchPageDto?
+
+    // 결과를 direct ByteBuffer 에 컬럼 형태로 기록하고 바이트 수를 반환한다 (TransactionColumns 로 읽음).
+    // 버퍼가 작으면 -(필요한 바이트 수), 오류 시 0. afterId 가 0 이면 첫 페이지.
+    private external fun getTransactionsColumnarNative(
+        walletId: Int,
+        afterDate: Long,
+        afterId: Int,
+        limit: Int,
+        buffer: java.nio.ByteBuffer
+    ): Int
+
     private external fun updateTransactionNative(
         id: Int,
         walletId: Int,
@@ -61,6 +123,16 @@ class TransactionListActivity : AppCompatActivity() {
 
     private external fun getWalletByIdNative(id: Int): com.example.pocketmoneyapp.data.WalletDto?
 
+    // date 시점까지의 지갑 잔액. 날짜가 잘못되었거나 오류면 Long.MIN_VALUE
+    private external fun balanceAtNative(walletId: Int, date: String): Long
+
+    // 지갑의 월별 합계 (yyyymm 오름차순). from/to 는 포함 범위이며 0 이면 제한 없음
+    private external fun getMonthlyTotalsNative(
+        walletId: Int,
+        fromYyyymm: Int,
+        toYyyymm: Int
+    ): Array<MonthlyTotalDto>
+
 
     override fun onCreate(savedInstanceState: Bundle?) {
         super.onCreate(savedInstanceState)
@@ -192,7 +264,8 @@ class TransactionListActivity : AppCompatActivity() {
                 else -> TransactionType.EXPENSE
             }
 
-            val currentDateTime = SimpleDateFormat("yyyy-MM-dd HH:mm:ss", Locale.getDefault()).format(Date())
+            // 네이티브 파서는 ASCII 숫자의 "YYYY-MM-DD HH:MM:SS" 만 받으므로 로케일 숫자를 쓰지 않는다
+            val currentDateTime = SimpleDateFormat("yyyy-MM-dd HH:mm:ss", Locale.US).format(Date())
 
             val success = createTransactionNative(
                 walletId,
@@ -267,7 +340,7 @@ class TransactionListActivity : AppCompatActivity() {
                 R.id.editRadioExpense -> TransactionType.EXPENSE
                 else -> TransactionType.EXPENSE
             }
-            val currentDateTime = SimpleDateFormat("yyyy-MM-dd HH:mm:ss", Locale.getDefault()).format(Date())
+            val currentDateTime = SimpleDateFormat("yyyy-MM-dd HH:mm:ss", Locale.US).format(Date())
 
             val success = updateTransactionNative(
                 transaction.id,
@@ -0,0 +1,7 @@
+package com.example.pocketmoneyapp.data
+
+// importTransactionsCsvNative 를 호출한 스레드에서 묶음마다 불린다. totalBytes 를 모르면 -1.
+// false 를 반환하면 가져오기를 취소한다.
+fun interface CsvImportProgressListener {
+    fun onProgress(bytesRead: Long, totalBytes: Long, rowsImported: Long, rowsRejected: Long): Boolean
+}
@@ -0,0 +1,11 @@
+package com.example.pocketmoneyapp.data
+
+// CSV 가져오기 결과. 취소/실패 시에도 rowsImported 만큼은 이미 커밋되어 남아 있다.
+// firstRejectedLine 은 처음 거부된 행의 줄 번호(1부터)이며 거부된 행이 없으면 0 이다.
+data class CsvImportResultDto(
+    val success: Boolean,
+    val cancelled: Boolean,
+    val rowsImported: Long,
+    val rowsRejected: Long,
+    val firstRejectedLine: Long
+)
@@ -0,0 +1,11 @@
+package com.example.pocketmoneyapp.data
+
+// 네이티브 리포지토리 연산 하나의 지연 분포 (단위: 나노초)
+data class LatencyStatDto(
+    val operation: String,
+    val count: Long,
+    val p50Nanos: Long,
+    val p95Nanos: Long,
+    val p99Nanos: Long,
+    val maxNanos: Long
+)
@@ -0,0 +1,10 @@
+package com.example.pocketmoneyapp.data
+
+// 지갑의 한 달 합계. yyyymm 은 202508 같은 연월
+data class MonthlyTotalDto(
+    val walletId: Int,
+    val yyyymm: Int,
+    val income: Long,
+    val expense: Long,
+    val count: Int
+)
@@ -0,0 +1,12 @@
+package com.example.pocketmoneyapp.data
+
+// 네이티브 거래 목록 페이지 캐시 통계. 횟수는 마지막 reset 이후 누적, bytes/entries 는 현재 값이다.
+data class PageCacheStatsDto(
+    val hits: Long,
+    val misses: Long,
+    val evictions: Long,
+    val invalidations: Long,
+    val bytes: Long,
+    val entries: Int,
+    val budgetBytes: Long
+)
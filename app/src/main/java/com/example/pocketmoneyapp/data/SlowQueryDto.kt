@@ -0,0 +1,11 @@
+package com.example.pocketmoneyapp.data
+
+// 네이티브 느린 쿼리 기록 한 건. sql 은 바인딩 값이 채워진 문장이다.
+data class SlowQueryDto(
+    val sql: String,
+    val durationNanos: Long,
+    val rows: Long,
+    val vmSteps: Int,
+    val fullScanSteps: Int,
+    val sorts: Int
+)
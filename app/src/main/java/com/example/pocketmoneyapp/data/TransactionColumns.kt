@@ -0,0 +1,67 @@
+package com.example.pocketmoneyapp.data
+
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+import java.text.SimpleDateFormat
+import java.util.Date
+import java.util.Locale
+import java.util.TimeZone
+
+/**
+ * getTransactionsColumnarNative 가 채운 direct ByteBuffer 를 행 단위 JNI 호출 없이 필요한 만큼만 읽는다.
+ * 레이아웃은 native_core 의 ColumnarTransactionWriter.h 참고.
+ */
+class TransactionColumns(buffer: ByteBuffer) {
+
+    private val buffer: ByteBuffer = buffer.duplicate().order(ByteOrder.nativeOrder())
+
+    val size: Int = this.buffer.getInt(4)
+    val hasMore: Boolean = (this.buffer.getInt(12) and FLAG_HAS_MORE) != 0
+    val nextDate: Long = this.buffer.getLong(16) // 다음 페이지 커서 (epoch 초)
+    val nextId: Int = this.buffer.getInt(24)
+
+    private val amountsOffset = HEADER_BYTES
+    private val datesOffset = amountsOffset + size * 8
+    private val idsOffset = datesOffset + size * 8
+    private val walletIdsOffset = idsOffset + size * 4
+    private val descriptionOffsetsOffset = walletIdsOffset + size * 4
+    private val typesOffset = descriptionOffsetsOffset + (size + 1) * 4
+    private val heapOffset = typesOffset + size
+
+    fun id(index: Int): Int = buffer.getInt(idsOffset + index * 4)
+    fun walletId(index: Int): Int = buffer.getInt(walletIdsOffset + index * 4)
+    fun amount(index: Int): Long = buffer.getLong(amountsOffset + index * 8)
+    fun type(index: Int): Int = buffer.get(typesOffset + index).toInt()
+    fun transactionDateEpoch(index: Int): Long = buffer.getLong(datesOffset + index * 8)
+
+    fun description(index: Int): String {
+        val start = buffer.getInt(descriptionOffsetsOffset + index * 4)
+        val end = buffer.getInt(descriptionOffsetsOffset + (index + 1) * 4)
+        val bytes = ByteArray(end - start)
+        val slice = buffer.duplicate()
+        slice.position(heapOffset + start)
+        slice.get(bytes)
+        return String(bytes, Charsets.UTF_8)
+    }
+
+    fun toDto(index: Int): TransactionDto = TransactionDto(
+        id(index),
+        walletId(index),
+        amount(index),
+        description(index),
+        type(index),
+        DATE_FORMAT.get()!!.format(Date(transactionDateEpoch(index) * 1000))
+    )
+
+    companion object {
+        private const val HEADER_BYTES = 32
+        private const val FLAG_HAS_MORE = 1
+
+        // 네이티브는 벽시계 시각을 그대로 epoch 로 저장하므로 UTC 로 되돌린다
+        private val DATE_FORMAT = object : ThreadLocal<SimpleDateFormat>() {
+            override fun initialValue() = SimpleDateFormat("yyyy-MM-dd HH:mm:ss", Locale.US).apply {
+                timeZone = TimeZone.getTimeZone("UTC")
+            }
+        }
+    }
+}
@@ -0,0 +1,7 @@
+package com.example.pocketmoneyapp.data
+
+// exportTransactionsNative 를 호출한 스레드에서 출력 버퍼를 비울 때마다 불린다.
+// false 를 반환하면 내보내기를 취소한다.
+fun interface TransactionExportProgressListener {
+    fun onProgress(rowsWritten: Long, bytesWritten: Long): Boolean
+}
@@ -0,0 +1,11 @@
+package com.example.pocketmoneyapp.data
+
+// 키셋 페이지네이션 결과. 다음 페이지 요청 시 (nextDate, nextId)를 커서로 넘긴다.
+// runningBalances[i] 는 transactions[i] 까지 반영된 지갑 잔액 (잔액 색인을 쓸 수 없으면 빈 배열).
+data class TransactionPageDto(
+    val transactions: Array<TransactionDto>,
+    val hasMore: Boolean,
+    val nextDate: String,
+    val nextId: Int,
+    val runningBalances: LongArray
+)
@@ -0,0 +1,9 @@
+package com.example.pocketmoneyapp.data
+
+// 설명 검색 결과. 관련도 순이며 다음 페이지 요청 시 (nextRank, nextId)를 커서로 넘긴다.
+data class TransactionSearchPageDto(
+    val transactions: Array<TransactionDto>,
+    val hasMore: Boolean,
+    val nextRank: Double,
+    val nextId: Int
+)
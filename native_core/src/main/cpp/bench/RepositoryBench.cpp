@@ -0,0 +1,639 @@
+//
+// Created by ss on 2025-08-07.
+//
+
+// 리포지토리 벤치마크. 합성 거래 데이터베이스를 만든 뒤 주요 연산의 p50/p99 지연과 ops/sec 를 JSON 으로 출력한다.
+//
+//   native_core_bench [--rows=1000,10000,100000] [--ops=1000] [--dir=/tmp] [--profile-rows=100000] [--out=result.json]
+//                     [--page-sizes=1000,10000,100000] [--log-level=3]   (실행 시점 로그 레벨. 컴파일된 로그 비용을 잴 때 stderr 를 /dev/null 로 보낸다)
+//
+// 출력 형식은 Google Benchmark 의 JSON (context + benchmarks) 을 따르므로 커밋 간 비교 도구를 그대로 쓸 수 있다.
+
+#include "../data/ColumnarTransactionWriter.h"
+#include "../data/ConnectionManager.h"
+#include "../data/CsvTransactionImporter.h"
+#include "../data/TransactionExporter.h"
+#include "../data/TransactionRepository.h"
+#include "../data/WalletRepository.h"
+#include "../data/WriteQueue.h"
+#include "../domain/DateTime.h"
+#include "../platform/Log.h"
+#include "../tools/LedgerGenerator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::vector<long long> rows{1000, 10000, 100000};
+        int ops = 1000;
+        std::string dir = "/tmp";
+        long long profileRows = 100000; // 이 크기 이하에서만 sqliteDefaults 프로필 비교 DB 를 추가로 만든다
+        std::vector<int> pageSizes{1000, 10000, 100000}; // 지갑 하나짜리 DB 에서 재는 페이지 전달 결과 크기
+        std::string out;
+    };
+
+    struct Result {
+        std::string name;
+        long long rows = 0;
+        long long iterations = 0;
+        double p50Ns = 0;
+        double p99Ns = 0;
+        double meanNs = 0;
+        double opsPerSec = 0;
+    };
+
+    std::vector<Result> g_results;
+
+    Result summarize(const std::string& name, long long rows, std::vector<double>& samples, double elapsedSec) {
+        Result result;
+        result.name = name;
+        result.rows = rows;
+        result.iterations = static_cast<long long>(samples.size());
+        if (samples.empty()) return result;
+        std::sort(samples.begin(), samples.end());
+        size_t n = samples.size();
+        result.p50Ns = samples[n / 2];
+        result.p99Ns = samples[std::min(n - 1, static_cast<size_t>(n * 0.99))];
+        double sum = 0;
+        for (double sample : samples) sum += sample;
+        result.meanNs = sum / n;
+        result.opsPerSec = elapsedSec > 0 ? n / elapsedSec : 0;
+        return result;
+    }
+
+    void record(const Result& result) {
+        std::fprintf(stderr, "%-60s %8lld it  p50 %10.0f ns  p99 %10.0f ns  %10.0f ops/s\n",
+                     result.name.c_str(), result.iterations, result.p50Ns, result.p99Ns, result.opsPerSec);
+        g_results.push_back(result);
+    }
+
+    // body(i) 를 iterations 번 호출하며 호출마다 지연을 잰다. body 가 false 를 돌려주면 실패로 보고 중단한다.
+    void measure(const std::string& name, long long rows, int iterations, const std::function<bool(int)>& body) {
+        std::vector<double> samples;
+        samples.reserve(iterations);
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            Clock::time_point begin = Clock::now();
+            if (!body(i)) {
+                std::fprintf(stderr, "[bench] %s failed at iteration %d\n", name.c_str(), i);
+                break;
+            }
+            samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - begin).count());
+        }
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        record(summarize(name, rows, samples, elapsed));
+    }
+
+    std::string benchName(const char* op, long long rows, const std::string& variant = "") {
+        std::string name = std::string(op) + "/rows:" + std::to_string(rows);
+        if (!variant.empty()) name += "/" + variant;
+        return name;
+    }
+
+    void removeDatabase(const std::string& path) {
+        unlink(path.c_str());
+        unlink((path + "-wal").c_str());
+        unlink((path + "-shm").c_str());
+    }
+
+    int walletCountFor(long long rows) {
+        return static_cast<int>(std::max(10LL, std::min(1000LL, rows / 1000)));
+    }
+
+    int64_t randomDate(std::mt19937_64& rng) {
+        // 2023-01-01 부터 2년 구간
+        static const int64_t base = 1672531200;
+        return base + static_cast<int64_t>(rng() % (2LL * 365 * 86400));
+    }
+
+    domain::Transaction randomTransaction(std::mt19937_64& rng, int walletCount) {
+        int walletId = 1 + static_cast<int>(rng() % walletCount);
+        bool income = rng() % 4 == 0;
+        long long amount = 100 + static_cast<long long>(rng() % 100000);
+        return domain::Transaction(walletId, income ? "salary" : "groceries", amount,
+                                   income ? domain::TransactionType::INCOME : domain::TransactionType::EXPENSE,
+                                   randomDate(rng));
+    }
+
+    // 벤치마크 한 크기에 필요한 커넥션과 리포지토리 묶음. 리포지토리는 쓰기 커넥션을 잡으므로 open() 이후에 만든다.
+    struct Fixture {
+        std::string path;
+        data::ConnectionManager connections;
+        std::unique_ptr<data::WalletRepository> walletRepo;
+        std::unique_ptr<data::TransactionRepository> transactionRepo;
+        int walletCount;
+
+        Fixture(const std::string& path, const data::OpenProfile& profile, int walletCount)
+                : path(path), connections(path, 2, profile), walletCount(walletCount) {}
+
+        bool open() {
+            if (!connections.open()) return false;
+            walletRepo = std::make_unique<data::WalletRepository>(connections);
+            transactionRepo = std::make_unique<data::TransactionRepository>(connections);
+            return true;
+        }
+
+        data::WalletRepository& wallets() { return *walletRepo; }
+        data::TransactionRepository& transactions() { return *transactionRepo; }
+    };
+
+    // 지갑 1..walletCount 와 rows 건의 거래를 합성 가계부 생성기로 한 번에 적재한다
+    bool seed(Fixture& fixture, long long rows) {
+        tools::LedgerConfig config;
+        config.wallets = fixture.walletCount;
+        config.transactions = rows;
+        auto writeLock = fixture.connections.lockWriter();
+        return tools::generateLedger(fixture.connections.writer(), config);
+    }
+
+    // walletCount 가 0 이면 행 수에 맞춰 정한다
+    std::unique_ptr<Fixture> openFixture(const Options& options, long long rows, const data::OpenProfile& profile,
+                                         const char* tag, int walletCount = 0) {
+        std::string path = options.dir + "/native_core_bench_" + tag + "_" + std::to_string(rows) + ".db";
+        removeDatabase(path);
+        auto fixture = std::make_unique<Fixture>(path, profile, walletCount > 0 ? walletCount : walletCountFor(rows));
+        if (!fixture->open()) {
+            std::fprintf(stderr, "[bench] cannot open %s\n", path.c_str());
+            return nullptr;
+        }
+        Clock::time_point start = Clock::now();
+        if (!seed(*fixture, rows)) {
+            std::fprintf(stderr, "[bench] seeding %lld rows failed\n", rows);
+            return nullptr;
+        }
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        std::fprintf(stderr, "[bench] seeded %lld rows across %d wallets (%s) in %.2f s\n",
+                     rows, fixture->walletCount, tag, elapsed);
+        return fixture;
+    }
+
+    void closeFixture(std::unique_ptr<Fixture>& fixture) {
+        if (!fixture) return;
+        std::string path = fixture->path;
+        fixture->connections.close();
+        fixture.reset();
+        removeDatabase(path);
+    }
+
+    // createTransaction / updateTransaction / deleteTransaction. 만든 거래를 수정한 뒤 지워 DB 크기를 유지한다.
+    void benchMutations(Fixture& fixture, long long rows, int ops, const std::string& variant) {
+        std::mt19937_64 rng(7);
+        std::vector<domain::Transaction> created;
+        created.reserve(ops);
+        measure(benchName("createTransaction", rows, variant), rows, ops, [&](int) {
+            domain::Transaction transaction = randomTransaction(rng, fixture.walletCount);
+            if (!fixture.transactions().createTransaction(transaction)) return false;
+            created.push_back(transaction);
+            return true;
+        });
+        measure(benchName("updateTransaction", rows, variant), rows, static_cast<int>(created.size()), [&](int i) {
+            domain::Transaction& transaction = created[i];
+            transaction.amount += 1;
+            transaction.walletId = 1 + static_cast<int>(rng() % fixture.walletCount);
+            return fixture.transactions().updateTransaction(transaction);
+        });
+        measure(benchName("deleteTransaction", rows, variant), rows, static_cast<int>(created.size()), [&](int i) {
+            return fixture.transactions().deleteTransaction(created[i].id);
+        });
+    }
+
+    void benchReads(Fixture& fixture, long long rows, int ops, const std::string& variant) {
+        int listOps = std::max(1, std::min(ops, 200));
+        measure(benchName("getTransactionsByWalletId", rows, variant), rows, listOps, [&](int i) {
+            int walletId = 1 + i % fixture.walletCount;
+            return !fixture.transactions().getTransactionsByWalletId(walletId).empty();
+        });
+        measure(benchName("getAllWallets", rows, variant), rows, listOps, [&](int) {
+            return static_cast<int>(fixture.wallets().getAllWallets().size()) == fixture.walletCount;
+        });
+        measure(benchName("recalculateBalance", rows, variant), rows, listOps, [&](int i) {
+            return fixture.wallets().recalculateBalance(1 + i % fixture.walletCount);
+        });
+    }
+
+    // 페이지 캐시(user-022) 적중이 섞이지 않도록 다른 측정은 캐시를 끈 채로 돈다. 켜고 끄는 비교는 benchPageCache 에서만 한다
+    void setPageCacheEnabled(Fixture& fixture, bool enabled) {
+        fixture.transactions().setPageCacheBudget(enabled ? data::TransactionPageCache::DEFAULT_BUDGET_BYTES : 0);
+    }
+
+    // user-022: 지갑 전체 목록과 첫 페이지 100건을 페이지 캐시에서 찾을 때(hit)와 SQLite 에서 읽을 때(miss)
+    void benchPageCache(Fixture& fixture, long long rows, int ops) {
+        int listOps = std::max(1, std::min(ops, 200));
+        int hotWallets = std::min(fixture.walletCount, 8); // 100만 건에서도 지갑 8개의 전체 목록은 기본 예산 안에 든다
+        for (bool enabled : {false, true}) {
+            std::string variant = enabled ? "cache:hit" : "cache:miss";
+            setPageCacheEnabled(fixture, enabled);
+            if (enabled) {
+                // 측정할 지갑을 한 번씩 읽어 둔다
+                for (int walletId = 1; walletId <= hotWallets; ++walletId) {
+                    fixture.transactions().getTransactionsByWalletId(walletId);
+                    fixture.transactions().getTransactionsPage(walletId, 0, 0, 100);
+                }
+                fixture.transactions().getPageCacheStats(true);
+            }
+            measure(benchName("getTransactionsByWalletId", rows, variant), rows, listOps, [&](int i) {
+                return !fixture.transactions().getTransactionsByWalletId(1 + i % hotWallets).empty();
+            });
+            measure(benchName("transactionsPage", rows, variant), rows, ops, [&](int i) {
+                return !fixture.transactions().getTransactionsPage(1 + i % hotWallets, 0, 0, 100).transactions.empty();
+            });
+            if (enabled) {
+                data::PageCacheStats stats = fixture.transactions().getPageCacheStats();
+                std::fprintf(stderr, "[bench] page cache: %llu hits, %llu misses, %zu entries, %zu bytes\n",
+                             static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses),
+                             stats.entries, stats.bytes);
+            }
+        }
+        setPageCacheEnabled(fixture, false);
+    }
+
+    // user-006: 읽기 스레드 여러 개가 첫 페이지를 읽는 동안 쓰기 스레드 하나가 거래를 계속 추가할 때의 읽기 지연.
+    // 쓰기 없이 같은 읽기를 돌린 writer:idle 과 비교한다. 읽기 스레드 수는 Fixture 의 읽기 풀 크기와 같다
+    void benchMixedLoad(Fixture& fixture, long long rows, int ops, const std::string& variant) {
+        const int readers = 2;
+        int readsPerThread = std::max(1, ops / readers);
+        for (bool writing : {false, true}) {
+            std::atomic<bool> stop{false};
+            std::atomic<bool> failed{false};
+            std::vector<double> writeSamples;
+            std::vector<int> createdIds;
+            std::thread writer;
+            if (writing) {
+                writer = std::thread([&] {
+                    std::mt19937_64 rng(61);
+                    while (!stop.load(std::memory_order_acquire)) {
+                        domain::Transaction transaction = randomTransaction(rng, fixture.walletCount);
+                        Clock::time_point begin = Clock::now();
+                        if (!fixture.transactions().createTransaction(transaction)) {
+                            failed = true;
+                            return;
+                        }
+                        writeSamples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - begin).count());
+                        createdIds.push_back(transaction.id);
+                    }
+                });
+            }
+
+            std::vector<std::vector<double>> perThread(readers);
+            std::vector<std::thread> threads;
+            Clock::time_point start = Clock::now();
+            for (int t = 0; t < readers; ++t) {
+                threads.emplace_back([&, t] {
+                    perThread[t].reserve(readsPerThread);
+                    for (int i = 0; i < readsPerThread; ++i) {
+                        int walletId = 1 + (i * readers + t) % fixture.walletCount;
+                        Clock::time_point begin = Clock::now();
+                        if (fixture.transactions().getTransactionsPage(walletId, 0, 0, 100).transactions.empty()) {
+                            failed = true;
+                            return;
+                        }
+                        perThread[t].push_back(std::chrono::duration<double, std::nano>(Clock::now() - begin).count());
+                    }
+                });
+            }
+            for (auto& thread : threads) thread.join();
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            stop = true;
+            if (writer.joinable()) writer.join();
+            if (failed) {
+                std::fprintf(stderr, "[bench] mixedLoad/%s failed\n", variant.c_str());
+            }
+
+            std::vector<double> samples;
+            for (auto& part : perThread) samples.insert(samples.end(), part.begin(), part.end());
+            std::string mode = std::string(writing ? "writer:busy" : "writer:idle") + "/readers:" + std::to_string(readers);
+            record(summarize(benchName("mixedLoadRead", rows, variant + "/" + mode), rows, samples, elapsed));
+            if (writing) {
+                record(summarize(benchName("mixedLoadWrite", rows, variant + "/" + mode), rows, writeSamples, elapsed));
+                for (int id : createdIds) fixture.transactions().deleteTransaction(id);
+            }
+        }
+    }
+
+    // user-001: 준비된 statement 캐시 on/off. 쓰기와 읽기 커넥션 모두에서 바꾼다.
+    // getWalletById 는 지갑 캐시를 끄고 재야 SQLite 조회가 된다
+    void benchStatementCache(Fixture& fixture, long long rows, int ops) {
+        fixture.connections.writer().getWalletCache().setEnabled(false);
+        for (bool enabled : {true, false}) {
+            std::string variant = enabled ? "stmt_cache:on" : "stmt_cache:off";
+            fixture.connections.setStatementCacheEnabled(enabled);
+            std::mt19937_64 rng(11);
+            std::vector<int> ids;
+            measure(benchName("createTransaction", rows, variant), rows, ops, [&](int) {
+                domain::Transaction transaction = randomTransaction(rng, fixture.walletCount);
+                if (!fixture.transactions().createTransaction(transaction)) return false;
+                ids.push_back(transaction.id);
+                return true;
+            });
+            for (int id : ids) fixture.transactions().deleteTransaction(id);
+            measure(benchName("getWalletById", rows, variant), rows, ops, [&](int i) {
+                return fixture.wallets().getWalletById(1 + i % fixture.walletCount).id != 0;
+            });
+            measure(benchName("getTransactionById", rows, variant), rows, ops, [&](int) {
+                int id = 1 + static_cast<int>(rng() % static_cast<uint64_t>(rows)); // 적재한 거래는 1..rows
+                return fixture.transactions().getTransactionById(id).id == id;
+            });
+        }
+        fixture.connections.setStatementCacheEnabled(true);
+        fixture.connections.writer().getWalletCache().setEnabled(true);
+    }
+
+    // user-004/005: 첫 페이지 limit 건을 도메인 객체 벡터로 만들 때와 컬럼형 버퍼에 직접 쓸 때.
+    // 호스트에는 JVM 이 없어 vector 쪽의 TransactionDto 배열 생성(newTransactionDtoArray)은 포함되지 않는다
+    void benchPageTransfer(Fixture& fixture, long long rows, int ops, int limit) {
+        ops = std::max(5, std::min(ops, static_cast<int>(ops * 100LL / limit))); // 반복마다 limit 건을 읽는다
+        std::string size = limit == 100 ? "" : "limit:" + std::to_string(limit) + "/"; // 100 건은 예전 이름 그대로
+        measure(benchName("transactionsPage", rows, size + "transfer:vector"), rows, ops, [&](int i) {
+            data::TransactionPage page = fixture.transactions().getTransactionsPage(1 + i % fixture.walletCount, 0, 0, limit);
+            return !page.transactions.empty();
+        });
+        std::vector<uint8_t> buffer(data::ColumnarTransactionWriter::fixedBytes(limit) + limit * 64);
+        measure(benchName("transactionsPage", rows, size + "transfer:columnar"), rows, ops, [&](int i) {
+            data::ColumnarTransactionWriter writer(buffer.data(), buffer.size(), limit);
+            bool hasMore = false;
+            bool ok = fixture.transactions().scanTransactionsPage(
+                    1 + i % fixture.walletCount, 0, 0, limit,
+                    [&writer](const data::TransactionRowView& row) { return writer.append(row); }, hasMore);
+            return ok && writer.finish(hasMore) > 0;
+        });
+    }
+
+    // user-010: 생산자 스레드 여러 개가 쓰기 큐에 createTransaction 을 넣을 때 그룹 커밋 창별 처리량
+    void benchGroupCommit(Fixture& fixture, long long rows, int ops) {
+        const int producers = 8;
+        struct Window { int maxOps; int delayUs; };
+        for (Window window : {Window{1, 0}, Window{8, 0}, Window{64, 0}, Window{64, 2000}}) {
+            data::GroupCommitWindow config;
+            config.maxOps = window.maxOps;
+            config.maxDelay = std::chrono::microseconds(window.delayUs);
+            std::vector<std::vector<double>> perThread(producers);
+            std::vector<std::vector<int>> createdIds(producers);
+            Clock::time_point start;
+            double elapsed;
+            {
+                data::WriteQueue queue(&fixture.connections, config);
+                std::vector<std::thread> threads;
+                start = Clock::now();
+                for (int t = 0; t < producers; ++t) {
+                    threads.emplace_back([&, t] {
+                        std::mt19937_64 rng(100 + t);
+                        for (int i = 0; i < ops / producers; ++i) {
+                            domain::Transaction transaction = randomTransaction(rng, fixture.walletCount);
+                            Clock::time_point begin = Clock::now();
+                            bool ok = queue.submit([&] { return fixture.transactions().createTransaction(transaction); }).get();
+                            perThread[t].push_back(std::chrono::duration<double, std::nano>(Clock::now() - begin).count());
+                            if (ok) createdIds[t].push_back(transaction.id);
+                        }
+                    });
+                }
+                for (auto& thread : threads) thread.join();
+                elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            }
+            std::vector<double> samples;
+            for (auto& part : perThread) samples.insert(samples.end(), part.begin(), part.end());
+            std::string variant = "window:" + std::to_string(window.maxOps) + "x" + std::to_string(window.delayUs) +
+                                  "us/threads:" + std::to_string(producers);
+            record(summarize(benchName("groupCommit", rows, variant), rows, samples, elapsed));
+
+            for (auto& ids : createdIds) {
+                for (int id : ids) fixture.transactions().deleteTransaction(id);
+            }
+        }
+    }
+
+    // user-019: 지갑 월별 추이를 MonthlyTotals 에서 읽을 때와 전체를 병렬로 다시 계산할 때
+    void benchMonthlyTotals(Fixture& fixture, long long rows, int ops) {
+        measure(benchName("getMonthlyTotals", rows), rows, ops, [&](int i) {
+            return !fixture.transactions().getMonthlyTotals(1 + i % fixture.walletCount).empty();
+        });
+        measure(benchName("rebuildMonthlyTotals", rows), rows, 3, [&](int) {
+            return fixture.transactions().rebuildMonthlyTotals();
+        });
+    }
+
+    // user-020: 특정 날짜 기준 잔액 (첫 호출은 지갑 색인을 읽는다) 과 누적 잔액을 붙인 첫 페이지
+    void benchBalanceAt(Fixture& fixture, long long rows, int ops) {
+        std::mt19937_64 rng(7);
+        measure(benchName("balanceAt", rows), rows, ops, [&](int i) {
+            long long balance = 0;
+            return fixture.transactions().balanceAt(1 + i % fixture.walletCount, randomDate(rng), balance);
+        });
+        measure(benchName("transactionsPage", rows, "runningBalances"), rows, ops, [&](int i) {
+            data::TransactionPage page = fixture.transactions().getTransactionsPage(1 + i % fixture.walletCount, 0, 0, 100, true);
+            return page.runningBalances.size() == page.transactions.size();
+        });
+    }
+
+    // 설명 검색. 합성 가계부의 설명은 어휘 15개 중 하나라 "카페" 는 전체의 약 9% 가 맞는 흔한 단어다
+    void benchSearch(Fixture& fixture, long long rows, int ops) {
+        int commonOps = std::max(1, std::min(ops, 50)); // 맞는 행 전체에 순위를 매기므로 행 수에 비례한다
+        measure(benchName("searchTransactions", rows, "query:common"), rows, commonOps, [&](int) {
+            return !fixture.transactions().searchTransactions("카페", 0, 50).transactions.empty();
+        });
+        measure(benchName("searchTransactions", rows, "query:common,wallet"), rows, ops, [&](int i) {
+            return !fixture.transactions().searchTransactions("카페", 1 + i % fixture.walletCount, 50).transactions.empty();
+        });
+        measure(benchName("searchTransactions", rows, "query:common,wallet,page:2"), rows, ops, [&](int i) {
+            data::TransactionSearchPage first = fixture.transactions().searchTransactions("카페", 1 + i % fixture.walletCount, 50);
+            if (!first.hasMore) return true;
+            return !fixture.transactions().searchTransactions("카페", 1 + i % fixture.walletCount, 50,
+                                                             first.nextRank, first.nextId).transactions.empty();
+        });
+        measure(benchName("searchTransactions", rows, "query:miss"), rows, ops, [&](int) {
+            return fixture.transactions().searchTransactions("없는단어", 0, 50).transactions.empty();
+        });
+    }
+
+    // 은행 내보내기 형태의 CSV 를 한 번 쓰고 반복해서 가져온다. 반복 한 번이 csvRows 건 가져오기 전체다
+    void benchCsvImport(Fixture& fixture, long long rows, int ops, const std::string& dir) {
+        const long long csvRows = 10000;
+        std::string csvPath = dir + "/native_core_bench_import.csv";
+        FILE* csv = std::fopen(csvPath.c_str(), "w");
+        if (!csv) {
+            std::fprintf(stderr, "[bench] cannot write %s\n", csvPath.c_str());
+            return;
+        }
+        std::mt19937_64 rng(24);
+        std::fputs("wallet_id,date,description,amount,type\n", csv);
+        for (long long i = 0; i < csvRows; ++i) {
+            domain::Transaction t = randomTransaction(rng, fixture.walletCount);
+            char date[domain::DATE_TIME_LENGTH + 1];
+            domain::formatDateTime(t.transactionDate, date);
+            std::fprintf(csv, "%d,%s,\"%s, %lld\",%lld,%d\n", t.walletId, date, t.description.c_str(), i,
+                         t.amount, static_cast<int>(t.type));
+        }
+        std::fclose(csv);
+
+        data::CsvTransactionImporter importer(fixture.connections, fixture.transactions());
+        measure(benchName("importCsv", rows, "rows:" + std::to_string(csvRows)), rows, std::max(1, std::min(ops, 5)), [&](int) {
+            data::CsvImportResult result = importer.importFile(csvPath);
+            return result.success && result.progress.rowsCommitted == csvRows;
+        });
+        unlink(csvPath.c_str());
+    }
+
+    // 원장 전체(와 지갑 하나)를 파일로 내보낸다. 반복 한 번이 내보내기 전체다
+    void benchExport(Fixture& fixture, long long rows, int ops, const std::string& dir) {
+        std::string path = dir + "/native_core_bench_export.out";
+        int iterations = std::max(1, std::min(ops, 5));
+        const struct {
+            data::ExportFormat format;
+            const char* label;
+        } formats[] = {{data::ExportFormat::CSV, "format:csv"}, {data::ExportFormat::JSON_LINES, "format:jsonl"}};
+        for (const auto& f : formats) {
+            data::ExportOptions options;
+            options.format = f.format;
+            data::TransactionExporter exporter(fixture.connections, options);
+            measure(benchName("exportAll", rows, f.label), rows, iterations, [&](int) {
+                return exporter.exportToFile(path).success;
+            });
+        }
+        data::ExportOptions walletOptions;
+        walletOptions.walletId = 1;
+        data::TransactionExporter walletExporter(fixture.connections, walletOptions);
+        measure(benchName("exportWallet", rows, "format:csv"), rows, iterations, [&](int) {
+            return walletExporter.exportToFile(path).success;
+        });
+        unlink(path.c_str());
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            if (std::strncmp(arg, "--rows=", 7) == 0) {
+                options.rows.clear();
+                for (const char* p = arg + 7; *p;) {
+                    char* end = nullptr;
+                    long long value = std::strtoll(p, &end, 10);
+                    if (end == p || value <= 0) return false;
+                    options.rows.push_back(value);
+                    p = *end == ',' ? end + 1 : end;
+                }
+            } else if (std::strncmp(arg, "--ops=", 6) == 0) {
+                options.ops = std::atoi(arg + 6);
+            } else if (std::strncmp(arg, "--dir=", 6) == 0) {
+                options.dir = arg + 6;
+            } else if (std::strncmp(arg, "--profile-rows=", 15) == 0) {
+                options.profileRows = std::atoll(arg + 15);
+            } else if (std::strncmp(arg, "--page-sizes=", 13) == 0) {
+                options.pageSizes.clear();
+                for (const char* p = arg + 13; *p;) {
+                    char* end = nullptr;
+                    long value = std::strtol(p, &end, 10);
+                    if (end == p || value <= 0 || value > 10000000) return false;
+                    options.pageSizes.push_back(static_cast<int>(value));
+                    p = *end == ',' ? end + 1 : end;
+                }
+            } else if (std::strncmp(arg, "--out=", 6) == 0) {
+                options.out = arg + 6;
+            } else if (std::strncmp(arg, "--log-level=", 12) == 0) {
+                platform::setLogLevel(std::atoi(arg + 12));
+            } else {
+                return false;
+            }
+        }
+        return options.ops > 0 && !options.rows.empty();
+    }
+
+    void writeJson(FILE* out) {
+        char date[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+        std::fprintf(out, "{\n  \"context\": {\n");
+        std::fprintf(out, "    \"date\": \"%s\",\n", date);
+        std::fprintf(out, "    \"executable\": \"native_core_bench\",\n");
+        std::fprintf(out, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+        std::fprintf(out, "    \"sqlite_version\": \"%s\"\n", sqlite3_libversion());
+        std::fprintf(out, "  },\n  \"benchmarks\": [\n");
+        for (size_t i = 0; i < g_results.size(); ++i) {
+            const Result& r = g_results[i];
+            std::fprintf(out,
+                         "    {\"name\": \"%s\", \"rows\": %lld, \"iterations\": %lld, \"p50_ns\": %.0f, "
+                         "\"p99_ns\": %.0f, \"mean_ns\": %.0f, \"ops_per_sec\": %.1f}%s\n",
+                         r.name.c_str(), r.rows, r.iterations, r.p50Ns, r.p99Ns, r.meanNs, r.opsPerSec,
+                         i + 1 < g_results.size() ? "," : "");
+        }
+        std::fprintf(out, "  ]\n}\n");
+    }
+
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--rows=1000,10000,100000] [--ops=1000] [--dir=/tmp] "
+                             "[--profile-rows=100000] [--out=result.json] [--page-sizes=1000,10000,100000] [--log-level=N]\n", argv[0]);
+        return 2;
+    }
+
+    for (long long rows : options.rows) {
+        std::unique_ptr<Fixture> tuned = openFixture(options, rows, data::OpenProfile(), "tuned");
+        if (!tuned) return 1;
+        setPageCacheEnabled(*tuned, false);
+        benchMutations(*tuned, rows, options.ops, "profile:tuned");
+        benchReads(*tuned, rows, options.ops, "profile:tuned");
+        benchMixedLoad(*tuned, rows, options.ops, "profile:tuned");
+        benchStatementCache(*tuned, rows, options.ops);
+        benchPageTransfer(*tuned, rows, options.ops, 100);
+        benchPageCache(*tuned, rows, options.ops);
+        benchGroupCommit(*tuned, rows, options.ops);
+        benchMonthlyTotals(*tuned, rows, options.ops);
+        benchBalanceAt(*tuned, rows, options.ops);
+        benchSearch(*tuned, rows, options.ops);
+        benchCsvImport(*tuned, rows, options.ops, options.dir);
+        benchExport(*tuned, rows, options.ops, options.dir);
+        closeFixture(tuned);
+
+        // user-006: 튜닝 프로필과 SQLite 기본 설정 비교 (같은 시드로 만든 별도 DB)
+        if (rows <= options.profileRows) {
+            std::unique_ptr<Fixture> defaults = openFixture(options, rows, data::OpenProfile::sqliteDefaults(), "defaults");
+            if (!defaults) return 1;
+            setPageCacheEnabled(*defaults, false);
+            benchMutations(*defaults, rows, options.ops, "profile:sqlite_defaults");
+            benchReads(*defaults, rows, options.ops, "profile:sqlite_defaults");
+            benchMixedLoad(*defaults, rows, options.ops, "profile:sqlite_defaults");
+            closeFixture(defaults);
+        }
+    }
+
+    // user-005: 큰 결과의 전달 비용. 지갑 하나에 가장 큰 페이지만큼 넣어 모든 크기가 실제로 limit 건을 돌려주게 한다
+    if (!options.pageSizes.empty()) {
+        int largest = *std::max_element(options.pageSizes.begin(), options.pageSizes.end());
+        std::unique_ptr<Fixture> transfer = openFixture(options, largest, data::OpenProfile(), "transfer", 1);
+        if (!transfer) return 1;
+        setPageCacheEnabled(*transfer, false);
+        for (int limit : options.pageSizes) {
+            benchPageTransfer(*transfer, largest, options.ops, limit);
+        }
+        closeFixture(transfer);
+    }
+
+    if (options.out.empty()) {
+        writeJson(stdout);
+    } else {
+        FILE* out = std::fopen(options.out.c_str(), "w");
+        if (!out) {
+            std::fprintf(stderr, "[bench] cannot write %s\n", options.out.c_str());
+            return 1;
+        }
+        writeJson(out);
+        std::fclose(out);
+    }
+    return 0;
+}
@@ -0,0 +1,303 @@
+//
+// Created by ss on 2025-08-12.
+//
+
+#include "BalanceIndex.h"
+#include "../domain/Transaction.h"
+#include <algorithm>
+#include "../platform/Log.h"
+
+#define LOG_TAG_DAL "NativeCoreDAL"
+#define LOGD_DAL(...) PLATFORM_LOGD(LOG_TAG_DAL, __VA_ARGS__)
+#define LOGE_DAL(...) PLATFORM_LOGE(LOG_TAG_DAL, __VA_ARGS__)
+
+namespace data {
+
+    namespace {
+
+        const char* const LOAD_SQL =
+                "SELECT ID, TransactionDate, Type, Amount FROM Transactions WHERE wallet_id = ? ORDER BY TransactionDate, ID;";
+
+        // 스키마 버전 2 백필 중에는 아직 옮겨지지 않은 거래가 Transactions_legacy 에 TEXT 날짜로 남아 있다
+        const char* const LOAD_WITH_LEGACY_SQL =
+                "SELECT ID, TransactionDate, Type, Amount FROM Transactions WHERE wallet_id = ?1 "
+                "UNION ALL SELECT ID, COALESCE(CAST(strftime('%s', TransactionDate) AS INTEGER), 0), Type, Amount "
+                "FROM Transactions_legacy WHERE wallet_id = ?1 ORDER BY 2, 1;";
+
+    }
+
+    void BalanceIndex::WalletTree::rebuild() {
+        size_t n = entries.size();
+        tree.assign(n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            tree[i] += entries[i].amount;
+            size_t parent = i | (i + 1);
+            if (parent < n) tree[parent] += tree[i];
+        }
+    }
+
+    void BalanceIndex::WalletTree::add(size_t index, long long delta) {
+        for (size_t i = index; i < tree.size(); i |= i + 1) {
+            tree[i] += delta;
+        }
+    }
+
+    long long BalanceIndex::WalletTree::prefix(size_t count) const {
+        long long sum = 0;
+        for (size_t i = count; i > 0; i &= i - 1) {
+            // i 는 1-based 끝 위치. tree[i - 1] 은 [(i - 1) & i, i) 구간의 합
+            sum += tree[i - 1];
+        }
+        return sum;
+    }
+
+    size_t BalanceIndex::WalletTree::upperBound(int64_t date, int id) const {
+        auto it = std::upper_bound(entries.begin(), entries.end(), std::make_pair(date, id),
+                                   [](const std::pair<int64_t, int>& key, const Entry& entry) {
+                                       return key.first != entry.date ? key.first < entry.date : key.second < entry.id;
+                                   });
+        return static_cast<size_t>(it - entries.begin());
+    }
+
+    void BalanceIndex::WalletTree::append(const Entry& entry) {
+        // 새 칸은 [(i & (i + 1)), i] 구간의 합을 갖는다
+        size_t i = entries.size();
+        long long covered = prefix(i) - prefix(i & (i + 1));
+        entries.push_back(entry);
+        tree.push_back(covered + entry.amount);
+    }
+
+    bool BalanceIndex::WalletTree::merge(std::vector<Entry>& added) {
+        auto before = [](const Entry& a, const Entry& b) { return a.date != b.date ? a.date < b.date : a.id < b.id; };
+        if (entries.empty() || before(entries.back(), added.front())) {
+            for (const Entry& entry : added) append(entry); // 모두 최근 거래
+            return true;
+        }
+        std::vector<Entry> merged;
+        merged.reserve(entries.size() + added.size());
+        auto existing = entries.begin();
+        for (const Entry& entry : added) {
+            while (existing != entries.end() && before(*existing, entry)) merged.push_back(*existing++);
+            if (existing != entries.end() && !before(entry, *existing)) {
+                if (!existing->removed) return false;
+                ++existing; // 같은 날짜로 수정된 거래는 지운 자리를 새 값으로 바꾼다
+                --removedCount;
+            }
+            merged.push_back(entry);
+        }
+        merged.insert(merged.end(), existing, entries.end());
+        entries.swap(merged);
+        rebuild();
+        return true;
+    }
+
+    void BalanceIndex::WalletTree::compact() {
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [](const Entry& entry) { return entry.removed; }),
+                      entries.end());
+        removedCount = 0;
+        rebuild();
+    }
+
+    BalanceIndex::BalanceIndex(DatabaseHelper& writer) : dbHelper(writer) {}
+
+    void BalanceIndex::syncLocked() {
+        if (pending.empty() || dbHelper.getOuterTransactionEnds() == pendingSince) return;
+        std::vector<Change> changes;
+        changes.swap(pending);
+        // DatabaseHelper 는 롤백 횟수를 바깥 트랜잭션 종료보다 먼저 올리므로 여기서 본 값에 그 트랜잭션의 롤백이 들어 있다
+        if (dbHelper.getRollbackCount() != pendingRollbacks) {
+            size_t dropped = 0;
+            for (const Change& change : changes) {
+                dropped += wallets.erase(change.transaction.walletId);
+            }
+            LOGD_DAL("[Info] Balance index dropped %zu wallets after a rollback.", dropped);
+            return;
+        }
+        applyLocked(changes);
+    }
+
+    void BalanceIndex::recordLocked(const Change& change) {
+        syncLocked();
+        if (!dbHelper.inTransaction()) {
+            std::vector<Change> changes{change};
+            applyLocked(changes);
+            return;
+        }
+        // 지갑이 아직 로드되지 않았어도 남긴다. 트랜잭션 안에서 마지막 커밋을 읽어 로드하면 커밋 때 이 변경이 더해져야 한다
+        if (pending.empty()) {
+            pendingSince = dbHelper.getOuterTransactionEnds();
+            pendingRollbacks = dbHelper.getRollbackCount();
+        }
+        pending.push_back(change);
+    }
+
+    void BalanceIndex::applyLocked(std::vector<Change>& changes) {
+        // 연속된 추가는 묶어서 지갑마다 한 번만 재구성한다. 삭제를 만나면 앞의 추가부터 반영해 순서를 지킨다
+        std::vector<Insertion> run;
+        for (const Change& change : changes) {
+            if (change.removed) {
+                insertBatchLocked(run);
+                run.clear();
+                removeLocked(change.transaction.walletId, change.transaction.date, change.transaction.id);
+            } else {
+                run.push_back(change.transaction);
+            }
+        }
+        insertBatchLocked(run);
+    }
+
+    bool BalanceIndex::balanceThrough(int walletId, int64_t date, int id, long long& balance) {
+        std::lock_guard<std::mutex> lock(mutex);
+        syncLocked();
+        auto it = wallets.find(walletId);
+        if (it == wallets.end()) return false;
+        balance = it->second.prefix(it->second.upperBound(date, id));
+        return true;
+    }
+
+    bool BalanceIndex::load(int walletId, DatabaseHelper& source) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            syncLocked();
+            if (wallets.count(walletId)) return true;
+        }
+
+        WalletTree wallet;
+        sqlite3_stmt* stmt = source.prepareCached(source.tableExists("Transactions_legacy") ? LOAD_WITH_LEGACY_SQL : LOAD_SQL);
+        if (!stmt) {
+            LOGE_DAL("[SQL Error] balance index prepare: %s", sqlite3_errmsg(source.getDb()));
+            return false;
+        }
+        sqlite3_bind_int(stmt, 1, walletId);
+        int rc;
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+            long long amount = sqlite3_column_int64(stmt, 3);
+            bool income = sqlite3_column_int(stmt, 2) == static_cast<int>(domain::TransactionType::INCOME);
+            wallet.entries.push_back({sqlite3_column_int64(stmt, 1), income ? amount : -amount,
+                                      sqlite3_column_int(stmt, 0), false});
+        }
+        source.releaseStatement(stmt);
+        if (rc != SQLITE_DONE) {
+            LOGE_DAL("[SQL Error] balance index load: %s", sqlite3_errmsg(source.getDb()));
+            return false;
+        }
+        wallet.rebuild();
+
+        // 쓰기 잠금 안이므로 읽는 동안 끝난 트랜잭션은 없다. 남은 pending 은 아직 열린 트랜잭션의 것이라 커밋 때 더해진다
+        std::lock_guard<std::mutex> lock(mutex);
+        syncLocked();
+        LOGD_DAL("[Info] Balance index loaded wallet %d (%zu transactions).", walletId, wallet.entries.size());
+        wallets[walletId] = std::move(wallet);
+        return true;
+    }
+
+    void BalanceIndex::onInserted(int walletId, int64_t date, int id, long long signedAmount) {
+        std::lock_guard<std::mutex> lock(mutex);
+        recordLocked({{walletId, date, id, signedAmount}, false});
+    }
+
+    void BalanceIndex::onInsertedBatch(const std::vector<Insertion>& insertions) {
+        std::lock_guard<std::mutex> lock(mutex);
+        syncLocked();
+        if (!dbHelper.inTransaction()) {
+            std::vector<Insertion> sorted(insertions);
+            insertBatchLocked(sorted);
+            return;
+        }
+        if (pending.empty()) {
+            pendingSince = dbHelper.getOuterTransactionEnds();
+            pendingRollbacks = dbHelper.getRollbackCount();
+        }
+        pending.reserve(pending.size() + insertions.size());
+        for (const Insertion& insertion : insertions) {
+            pending.push_back({insertion, false});
+        }
+    }
+
+    void BalanceIndex::onRemoved(int walletId, int64_t date, int id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        recordLocked({{walletId, date, id, 0}, true});
+    }
+
+    void BalanceIndex::insertLocked(const Insertion& insertion) {
+        auto it = wallets.find(insertion.walletId);
+        if (it == wallets.end()) return;
+        WalletTree& wallet = it->second;
+
+        size_t position = wallet.upperBound(insertion.date, insertion.id);
+        if (position > 0 && wallet.entries[position - 1].date == insertion.date && wallet.entries[position - 1].id == insertion.id) {
+            Entry& entry = wallet.entries[position - 1];
+            if (!entry.removed) {
+                wallets.erase(it); // 이미 있는 거래: 색인이 DB 와 어긋났으므로 다음 조회에서 다시 읽는다
+                return;
+            }
+            // 같은 날짜로 수정된 거래는 지운 자리를 되살린다
+            entry.removed = false;
+            entry.amount = insertion.signedAmount;
+            --wallet.removedCount;
+            wallet.add(position - 1, insertion.signedAmount);
+            return;
+        }
+
+        Entry entry{insertion.date, insertion.signedAmount, insertion.id, false};
+        if (position == wallet.entries.size()) {
+            wallet.append(entry);
+        } else {
+            wallet.entries.insert(wallet.entries.begin() + static_cast<std::ptrdiff_t>(position), entry);
+            wallet.rebuild();
+        }
+    }
+
+    void BalanceIndex::insertBatchLocked(std::vector<Insertion>& insertions) {
+        if (insertions.size() == 1) {
+            insertLocked(insertions.front());
+            return;
+        }
+        std::sort(insertions.begin(), insertions.end(), [](const Insertion& a, const Insertion& b) {
+            if (a.walletId != b.walletId) return a.walletId < b.walletId;
+            return a.date != b.date ? a.date < b.date : a.id < b.id;
+        });
+        std::vector<Entry> added;
+        for (size_t begin = 0, end; begin < insertions.size(); begin = end) {
+            int walletId = insertions[begin].walletId;
+            for (end = begin + 1; end < insertions.size() && insertions[end].walletId == walletId; ++end) {}
+            auto it = wallets.find(walletId);
+            if (it == wallets.end()) continue;
+
+            added.clear();
+            for (size_t i = begin; i < end; ++i) {
+                added.push_back({insertions[i].date, insertions[i].signedAmount, insertions[i].id, false});
+            }
+            if (!it->second.merge(added)) {
+                wallets.erase(it); // 이미 있는 키: 색인이 DB 와 어긋났으므로 다음 조회에서 다시 읽는다
+            }
+        }
+    }
+
+    void BalanceIndex::removeLocked(int walletId, int64_t date, int id) {
+        auto it = wallets.find(walletId);
+        if (it == wallets.end()) return;
+        WalletTree& wallet = it->second;
+
+        size_t position = wallet.upperBound(date, id);
+        if (position == 0 || wallet.entries[position - 1].date != date || wallet.entries[position - 1].id != id ||
+            wallet.entries[position - 1].removed) {
+            wallets.erase(it);
+            return;
+        }
+        Entry& entry = wallet.entries[position - 1];
+        wallet.add(position - 1, -entry.amount);
+        entry.amount = 0;
+        entry.removed = true;
+        if (++wallet.removedCount * 2 > wallet.entries.size()) {
+            wallet.compact();
+        }
+    }
+
+    void BalanceIndex::clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        wallets.clear();
+        pending.clear();
+    }
+
+}
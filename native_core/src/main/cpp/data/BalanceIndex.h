@@ -0,0 +1,98 @@
+//
+// Created by ss on 2025-08-12.
+//
+
+#ifndef POCKETMONEYAPP_BALANCEINDEX_H
+#define POCKETMONEYAPP_BALANCEINDEX_H
+
+#include "DatabaseHelper.h"
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace data {
+
+    // 지갑별 (TransactionDate, ID) 순 거래 금액의 Fenwick 트리. 특정 시점까지의 잔액을 O(log n) 으로 구한다.
+    // 트리는 커밋된 거래만 담으므로 읽기 커넥션이 보는 마지막 커밋과 같은 값을 돌려준다.
+    //  - 지갑은 처음 조회할 때 load 로 한 번 읽어 만든다 (쓰기 잠금을 잡고, 마지막 커밋을 보는 커넥션에서).
+    //  - TransactionRepository 는 거래 변경을 자기 트랜잭션 안에서 onInserted/onRemoved 로 알린다.
+    //    변경은 pending 에 모였다가 가장 바깥 트랜잭션이 커밋된 뒤 다음 호출에서 트리에 반영된다.
+    //    가장 최근 거래 추가는 O(log n), 과거 날짜 삽입은 메모리 안에서 O(n) 재구성이다.
+    //    여러 건은 onInsertedBatch 로 넘기면 지갑마다 정렬 병합 후 한 번만 재구성한다.
+    //  - pending 을 모으는 동안 롤백이 있었으면 어느 변경이 남았는지 모르므로 그 변경이 닿은 지갑만 버리고 다시 읽는다.
+    // 거래 한 건당 32바이트를 쓴다.
+    class BalanceIndex {
+    private:
+        struct Entry {
+            int64_t date;      // epoch 초
+            long long amount;  // 부호 있는 금액 (수입 +, 지출 -)
+            int id;
+            bool removed;      // 지운 거래. 키는 남겨 두고 금액만 0 으로 만든다
+        };
+
+        struct WalletTree {
+            std::vector<Entry> entries; // (date, id) 오름차순
+            std::vector<long long> tree; // 0-based Fenwick
+            size_t removedCount = 0;
+
+            void rebuild();
+            void add(size_t index, long long delta);
+            long long prefix(size_t count) const; // entries[0, count) 의 합
+            size_t upperBound(int64_t date, int id) const;
+            void append(const Entry& entry);
+            // added 는 (date, id) 오름차순. 지운 키는 되살리고, 살아 있는 키가 섞여 있으면 false
+            bool merge(std::vector<Entry>& added);
+            void compact();
+        };
+
+    public:
+        struct Insertion {
+            int walletId;
+            int64_t date;
+            int id;
+            long long signedAmount;
+        };
+
+    private:
+        struct Change {
+            Insertion transaction; // 지운 거래는 signedAmount 를 쓰지 않는다
+            bool removed;
+        };
+
+        DatabaseHelper& dbHelper; // 쓰기 커넥션 (트랜잭션 상태 확인용)
+        std::mutex mutex;
+        std::unordered_map<int, WalletTree> wallets;
+        std::vector<Change> pending;   // 아직 끝나지 않은 바깥 트랜잭션의 변경 (들어온 순서)
+        uint64_t pendingSince = 0;     // pending 을 모을 때의 getOuterTransactionEnds()
+        uint64_t pendingRollbacks = 0; // pending 을 모을 때의 getRollbackCount()
+
+        // 이하 mutex 를 잡은 상태에서 호출
+        void syncLocked(); // 끝난 트랜잭션의 pending 을 반영하거나 버린다
+        void recordLocked(const Change& change);
+        void applyLocked(std::vector<Change>& changes);
+        void insertLocked(const Insertion& insertion);
+        void insertBatchLocked(std::vector<Insertion>& insertions); // insertions 의 순서를 바꾼다
+        void removeLocked(int walletId, int64_t date, int id);
+
+    public:
+
+        explicit BalanceIndex(DatabaseHelper& writer);
+
+        // (date, id) 이하 거래의 합. 지갑이 아직 로드되지 않았으면 false
+        bool balanceThrough(int walletId, int64_t date, int id, long long& balance);
+
+        // source 에서 지갑의 거래를 읽어 트리를 만든다. 쓰기 잠금을 잡고 호출하며, source 는 마지막 커밋을 봐야 한다
+        // (열린 쓰기 트랜잭션 안이면 쓰기 커넥션 대신 읽기 커넥션)
+        bool load(int walletId, DatabaseHelper& source);
+
+        // 쓰기 커넥션을 잡은 스레드에서 변경을 일으킨 트랜잭션 안에서 호출한다. 트랜잭션 밖이면 바로 반영한다
+        void onInserted(int walletId, int64_t date, int id, long long signedAmount);
+        void onInsertedBatch(const std::vector<Insertion>& insertions);
+        void onRemoved(int walletId, int64_t date, int id);
+        void clear();
+    };
+
+}
+
+#endif //POCKETMONEYAPP_BALANCEINDEX_H
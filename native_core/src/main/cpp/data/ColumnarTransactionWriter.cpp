@@ -0,0 +1,124 @@
+//
+// Created by ss on 2025-08-04.
+//
+
+#include "ColumnarTransactionWriter.h"
+#include <cstring>
+
+namespace data {
+
+    namespace {
+
+        // 각 컬럼의 시작 위치 (rows 행 기준)
+        struct ColumnLayout {
+            size_t amounts;
+            size_t dates;
+            size_t ids;
+            size_t walletIds;
+            size_t descriptionOffsets;
+            size_t types;
+            size_t heap;
+
+            explicit ColumnLayout(int rows) {
+                size_t n = static_cast<size_t>(rows);
+                amounts = ColumnarTransactionWriter::HEADER_BYTES;
+                dates = amounts + n * sizeof(int64_t);
+                ids = dates + n * sizeof(int64_t);
+                walletIds = ids + n * sizeof(int32_t);
+                descriptionOffsets = walletIds + n * sizeof(int32_t);
+                types = descriptionOffsets + (n + 1) * sizeof(int32_t);
+                heap = types + n;
+            }
+        };
+
+        template <typename T>
+        void store(uint8_t* base, size_t offset, T value) {
+            std::memcpy(base + offset, &value, sizeof(T));
+        }
+
+    }
+
+    ColumnarTransactionWriter::ColumnarTransactionWriter(uint8_t* buffer, size_t capacity, int maxRows)
+            : buffer(buffer), capacity(capacity), maxRows(maxRows > 0 ? maxRows : 0), rows(0), heapBytes(0),
+              overflow(false), lastDate(0), lastId(0) {
+        if (!buffer || capacity < fixedBytes(this->maxRows)) {
+            overflow = true;
+        } else {
+            store<int32_t>(buffer, ColumnLayout(this->maxRows).descriptionOffsets, 0);
+        }
+    }
+
+    size_t ColumnarTransactionWriter::fixedBytes(int rows) {
+        return ColumnLayout(rows).heap;
+    }
+
+    bool ColumnarTransactionWriter::append(const TransactionRowView& row) {
+        if (rows >= maxRows) {
+            overflow = true;
+            return false;
+        }
+
+        int64_t date = row.transactionDate;
+        lastDate = date;
+        lastId = row.id;
+
+        size_t descriptionBytes = static_cast<size_t>(row.descriptionBytes);
+        ColumnLayout layout(maxRows);
+        if (!overflow && layout.heap + heapBytes + descriptionBytes > capacity) {
+            overflow = true;
+        }
+        if (!overflow) {
+            size_t i = static_cast<size_t>(rows);
+            store<int64_t>(buffer, layout.amounts + i * sizeof(int64_t), row.amount);
+            store<int64_t>(buffer, layout.dates + i * sizeof(int64_t), date);
+            store<int32_t>(buffer, layout.ids + i * sizeof(int32_t), row.id);
+            store<int32_t>(buffer, layout.walletIds + i * sizeof(int32_t), row.walletId);
+            store<int8_t>(buffer, layout.types + i, static_cast<int8_t>(row.type));
+            std::memcpy(buffer + layout.heap + heapBytes, row.description, descriptionBytes);
+            store<int32_t>(buffer, layout.descriptionOffsets + (i + 1) * sizeof(int32_t),
+                           static_cast<int32_t>(heapBytes + descriptionBytes));
+        }
+        heapBytes += descriptionBytes;
+        ++rows;
+        return !overflow;
+    }
+
+    size_t ColumnarTransactionWriter::finish(bool hasMore) {
+        if (overflow) return 0;
+
+        // maxRows 기준으로 잡아둔 컬럼을 실제 행 수 기준 위치로 당긴다.
+        // 최종 위치는 항상 임시 위치보다 앞이므로 앞 컬럼부터 memmove 하면 겹쳐 쓰지 않는다.
+        ColumnLayout from(maxRows);
+        ColumnLayout to(rows);
+        size_t n = static_cast<size_t>(rows);
+        std::memmove(buffer + to.dates, buffer + from.dates, n * sizeof(int64_t));
+        std::memmove(buffer + to.ids, buffer + from.ids, n * sizeof(int32_t));
+        std::memmove(buffer + to.walletIds, buffer + from.walletIds, n * sizeof(int32_t));
+        std::memmove(buffer + to.descriptionOffsets, buffer + from.descriptionOffsets, (n + 1) * sizeof(int32_t));
+        std::memmove(buffer + to.types, buffer + from.types, n);
+        std::memmove(buffer + to.heap, buffer + from.heap, heapBytes);
+
+        store<int32_t>(buffer, 0, VERSION);
+        store<int32_t>(buffer, 4, rows);
+        store<int32_t>(buffer, 8, static_cast<int32_t>(heapBytes));
+        store<int32_t>(buffer, 12, hasMore ? FLAG_HAS_MORE : 0);
+        store<int64_t>(buffer, 16, rows > 0 ? lastDate : 0);
+        store<int32_t>(buffer, 24, rows > 0 ? lastId : 0);
+        store<int32_t>(buffer, 28, 0);
+        return to.heap + heapBytes;
+    }
+
+    bool ColumnarTransactionWriter::overflowed() const {
+        return overflow;
+    }
+
+    size_t ColumnarTransactionWriter::requiredBytes() const {
+        // 기록 중에는 maxRows 기준 레이아웃을 쓰므로 재시도에 필요한 용량도 그 기준이다
+        return fixedBytes(maxRows) + heapBytes;
+    }
+
+    int ColumnarTransactionWriter::rowCount() const {
+        return rows;
+    }
+
+}
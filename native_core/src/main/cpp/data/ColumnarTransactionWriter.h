@@ -0,0 +1,54 @@
+//
+// Created by ss on 2025-08-04.
+//
+
+#ifndef POCKETMONEYAPP_COLUMNARTRANSACTIONWRITER_H
+#define POCKETMONEYAPP_COLUMNARTRANSACTIONWRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "TransactionRepository.h"
+
+namespace data {
+
+    // 거래 목록을 direct ByteBuffer 로 넘기기 위한 컬럼 지향 레이아웃 (네이티브 바이트 순서).
+    //
+    //  [0]  int32 version        [4]  int32 rowCount
+    //  [8]  int32 heapBytes      [12] int32 flags (bit0: hasMore)
+    //  [16] int64 nextDate       [24] int32 nextId     [28] int32 reserved
+    //  [32] int64 amount[n] | int64 date[n] (epoch 초) | int32 id[n] | int32 walletId[n]
+    //       | int32 descriptionOffset[n + 1] | int8 type[n] | UTF-8 description heap
+    //
+    // i 번째 설명은 heap[descriptionOffset[i], descriptionOffset[i + 1]) 이다.
+    class ColumnarTransactionWriter {
+    public:
+        static constexpr int32_t VERSION = 1;
+        static constexpr size_t HEADER_BYTES = 32;
+        static constexpr int32_t FLAG_HAS_MORE = 1;
+
+        // maxRows 행까지 기록할 수 있도록 buffer 안에 컬럼 자리를 잡는다
+        ColumnarTransactionWriter(uint8_t* buffer, size_t capacity, int maxRows);
+
+        bool append(const TransactionRowView& row); // 용량 초과 시 false (필요 크기는 계속 누적)
+        size_t finish(bool hasMore); // 컬럼을 실제 행 수에 맞게 당기고 기록된 바이트 수 반환 (초과 시 0)
+
+        bool overflowed() const;
+        size_t requiredBytes() const; // 같은 maxRows 로 모든 행을 담는 데 필요한 버퍼 용량
+        int rowCount() const;
+
+        static size_t fixedBytes(int rows); // 헤더 + 고정 폭 컬럼 크기
+
+    private:
+        uint8_t* buffer;
+        size_t capacity;
+        int maxRows;
+        int rows;
+        size_t heapBytes;
+        bool overflow;
+        int64_t lastDate;
+        int32_t lastId;
+    };
+
+}
+
+#endif //POCKETMONEYAPP_COLUMNARTRANSACTIONWRITER_H
@@ -0,0 +1,203 @@
+//
+// Created by ss on 2025-08-05.
+//
+
+#include "ConnectionManager.h"
+#include "../platform/Log.h"
+
+#define LOG_TAG_DAL "NativeCoreDAL"
+#define LOGD_DAL(...) PLATFORM_LOGD(LOG_TAG_DAL, __VA_ARGS__)
+#define LOGE_DAL(...) PLATFORM_LOGE(LOG_TAG_DAL, __VA_ARGS__)
+
+namespace data {
+
+    namespace {
+
+        constexpr int SCAN_CACHE_KIB = 1024; // openScanReader 커넥션의 cache_size
+
+    }
+
+    ConnectionManager::ConnectionManager(const std::string& path, int readerCount, const OpenProfile& profile,
+                                         std::chrono::milliseconds startupMigrationBudget)
+            : dbPath(path), profile(profile), readerCount(readerCount > 0 ? readerCount : 0),
+              startupMigrationBudget(startupMigrationBudget) {}
+
+    ConnectionManager::~ConnectionManager() {
+        close();
+    }
+
+    bool ConnectionManager::open() {
+        if (writerHelper) return true;
+
+        auto started = std::chrono::steady_clock::now();
+        auto writerConnection = std::make_unique<DatabaseHelper>(dbPath, profile);
+        if (!writerConnection->openDatabase() || !writerConnection->createTables()) {
+            LOGE_DAL("[Error] Writer connection open failed.");
+            return false;
+        }
+        // 스키마 단계에 쓴 시간을 빼고 남은 예산만큼만 백필한다
+        SchemaMigrator migrator(*writerConnection);
+        auto remaining = startupMigrationBudget -
+                         std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+        MigrationStatus migration = MigrationStatus::COMPLETE;
+        if (remaining.count() > 0) {
+            migration = migrator.runBackfills(remaining);
+        } else if (migrator.hasPendingBackfills()) {
+            migration = MigrationStatus::PENDING;
+        }
+        if (migration == MigrationStatus::FAILED) {
+            LOGE_DAL("[Error] Schema backfill failed.");
+            return false;
+        }
+        if (migration == MigrationStatus::PENDING) {
+            LOGD_DAL("[Info] Schema backfill continues after startup.");
+        }
+
+        // 읽기 전용 풀은 WAL 에서만 의미가 있다 (rollback journal 에서는 쓰기와 서로 막는다)
+        int pooled = profile.walJournal ? readerCount : 0;
+        OpenProfile readerProfile = profile;
+        readerProfile.readOnly = true;
+        std::vector<std::unique_ptr<DatabaseHelper>> readerConnections;
+        for (int i = 0; i < pooled; ++i) {
+            auto reader = std::make_unique<DatabaseHelper>(dbPath, readerProfile);
+            if (!reader->openDatabase()) {
+                LOGE_DAL("[Error] Reader connection %d open failed.", i);
+                return false;
+            }
+            readerConnections.push_back(std::move(reader));
+        }
+
+        std::lock_guard<std::mutex> lock(readerMutex);
+        writerHelper = std::move(writerConnection);
+        readers = std::move(readerConnections);
+        idleReaders.clear();
+        for (auto& reader : readers) {
+            idleReaders.push_back(reader.get());
+        }
+        readerCount = pooled;
+        LOGD_DAL("[Info] Connection pool opened: 1 writer, %d readers.", pooled);
+        return true;
+    }
+
+    void ConnectionManager::close() {
+        std::lock_guard<std::recursive_mutex> writeLock(writerMutex);
+        std::unique_lock<std::mutex> lock(readerMutex);
+        // 대여 중인 읽기 커넥션이 모두 반납될 때까지 기다린다
+        readerAvailable.wait(lock, [this] { return idleReaders.size() == readers.size(); });
+        idleReaders.clear();
+        readers.clear();
+        writerHelper.reset();
+        slowQueryLog.reset();
+    }
+
+    MigrationStatus ConnectionManager::continueMigrations(std::chrono::milliseconds budget) {
+        auto writeLock = lockWriter();
+        if (!writerHelper) return MigrationStatus::FAILED;
+        return SchemaMigrator(*writerHelper).runBackfills(budget);
+    }
+
+    bool ConnectionManager::hasPendingMigrations() {
+        auto writeLock = lockWriter();
+        return writerHelper && SchemaMigrator(*writerHelper).hasPendingBackfills();
+    }
+
+    DatabaseHelper& ConnectionManager::writer() {
+        return *writerHelper;
+    }
+
+    std::unique_lock<std::recursive_mutex> ConnectionManager::lockWriter() {
+        return std::unique_lock<std::recursive_mutex>(writerMutex);
+    }
+
+    std::unique_ptr<DatabaseHelper> ConnectionManager::openScanReader() {
+        if (!writerHelper || !profile.walJournal) return nullptr;
+        OpenProfile scanProfile = profile;
+        scanProfile.readOnly = true;
+        scanProfile.cacheSizeKiB = SCAN_CACHE_KIB;
+        auto reader = std::make_unique<DatabaseHelper>(dbPath, scanProfile);
+        if (!reader->openDatabase()) {
+            LOGE_DAL("[Error] Scan reader open failed.");
+            return nullptr;
+        }
+        return reader;
+    }
+
+    DatabaseHelper* ConnectionManager::acquireReader() {
+        std::unique_lock<std::mutex> lock(readerMutex);
+        if (readers.empty()) return nullptr;
+        readerAvailable.wait(lock, [this] { return !idleReaders.empty(); });
+        DatabaseHelper* reader = idleReaders.back();
+        idleReaders.pop_back();
+        return reader;
+    }
+
+    void ConnectionManager::releaseReader(DatabaseHelper* reader) {
+        if (!reader) return;
+        {
+            std::lock_guard<std::mutex> lock(readerMutex);
+            idleReaders.push_back(reader);
+        }
+        readerAvailable.notify_all();
+    }
+
+    int ConnectionManager::getReaderCount() const {
+        return readerCount;
+    }
+
+    void ConnectionManager::setStatementCacheEnabled(bool enabled) {
+        // 끌 때 캐시된 statement 를 finalize 하므로 대여 중인 읽기 커넥션이 없을 때 바꾼다
+        std::lock_guard<std::recursive_mutex> writeLock(writerMutex);
+        std::unique_lock<std::mutex> lock(readerMutex);
+        if (!writerHelper) return;
+        readerAvailable.wait(lock, [this] { return idleReaders.size() == readers.size(); });
+
+        writerHelper->setStatementCacheEnabled(enabled);
+        for (auto& reader : readers) {
+            reader->setStatementCacheEnabled(enabled);
+        }
+        LOGD_DAL("[Info] Statement cache %s on %zu connections.", enabled ? "enabled" : "disabled", readers.size() + 1);
+    }
+
+    bool ConnectionManager::setSlowQueryLog(size_t capacity, int64_t thresholdNanos) {
+        // 쓰기 잠금 + 모든 읽기 커넥션 반납 상태에서 교체해 trace 콜백이 옛 log 를 보지 않게 한다
+        std::lock_guard<std::recursive_mutex> writeLock(writerMutex);
+        std::unique_lock<std::mutex> lock(readerMutex);
+        if (!writerHelper) return false;
+        readerAvailable.wait(lock, [this] { return idleReaders.size() == readers.size(); });
+
+        std::unique_ptr<SlowQueryLog> log = capacity > 0 ? std::make_unique<SlowQueryLog>(capacity, thresholdNanos) : nullptr;
+        bool ok = writerHelper->setSlowQueryLog(log.get());
+        for (auto& reader : readers) {
+            ok = reader->setSlowQueryLog(log.get()) && ok;
+        }
+        slowQueryLog = std::move(log);
+        LOGD_DAL("[Info] Slow query log %s (capacity %zu).", slowQueryLog ? "enabled" : "disabled", capacity);
+        return ok;
+    }
+
+    std::vector<SlowQueryEntry> ConnectionManager::getSlowQueries(bool reset) {
+        std::lock_guard<std::mutex> lock(readerMutex);
+        return slowQueryLog ? slowQueryLog->snapshot(reset) : std::vector<SlowQueryEntry>();
+    }
+
+    ReadConnection::ReadConnection(ConnectionManager* manager, DatabaseHelper& fallback)
+            : manager(manager), reader(nullptr), fallback(fallback) {
+        if (manager) {
+            reader = manager->acquireReader();
+            if (!reader) {
+                writerLock = manager->lockWriter();
+            }
+        }
+    }
+
+    ReadConnection::~ReadConnection() {
+        if (manager && reader) {
+            manager->releaseReader(reader);
+        }
+    }
+
+    DatabaseHelper& ReadConnection::helper() {
+        return reader ? *reader : fallback;
+    }
+
+}
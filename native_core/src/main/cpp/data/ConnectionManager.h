@@ -0,0 +1,96 @@
+//
+// Created by ss on 2025-08-05.
+//
+
+#ifndef POCKETMONEYAPP_CONNECTIONMANAGER_H
+#define POCKETMONEYAPP_CONNECTIONMANAGER_H
+
+#include "DatabaseHelper.h"
+#include "SchemaMigrator.h"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace data {
+
+    // 쓰기 커넥션 1개와 읽기 전용 커넥션 N개를 관리한다.
+    // WAL 모드에서는 읽기 커넥션이 진행 중인 쓰기와 관계없이 마지막 커밋 스냅샷을 병렬로 읽을 수 있다.
+    class ConnectionManager {
+    public:
+        // 시작 시 백필에 쓰는 최대 시간. 남은 작업은 continueMigrations 로 나누어 이어간다
+        static constexpr std::chrono::milliseconds DEFAULT_STARTUP_MIGRATION_BUDGET{200};
+
+    private:
+        std::string dbPath;
+        OpenProfile profile;
+        int readerCount;
+        std::chrono::milliseconds startupMigrationBudget;
+
+        std::unique_ptr<DatabaseHelper> writerHelper;
+        std::recursive_mutex writerMutex; // 같은 스레드의 중첩 트랜잭션(SAVEPOINT) 허용
+
+        std::vector<std::unique_ptr<DatabaseHelper>> readers;
+        std::vector<DatabaseHelper*> idleReaders;
+        std::mutex readerMutex;
+        std::condition_variable readerAvailable;
+
+        std::unique_ptr<SlowQueryLog> slowQueryLog;
+
+    public:
+        ConnectionManager(const std::string& path, int readerCount, const OpenProfile& profile = OpenProfile(),
+                          std::chrono::milliseconds startupMigrationBudget = DEFAULT_STARTUP_MIGRATION_BUDGET);
+        ~ConnectionManager();
+
+        ConnectionManager(const ConnectionManager&) = delete;
+        ConnectionManager& operator=(const ConnectionManager&) = delete;
+
+        bool open(); // 쓰기 커넥션을 열어 테이블을 만든 뒤 읽기 커넥션을 연다
+        void close();
+
+        // 쓰기 잠금을 잡고 budget 동안 남은 백필을 진행한다
+        MigrationStatus continueMigrations(std::chrono::milliseconds budget);
+        bool hasPendingMigrations();
+
+        DatabaseHelper& writer();
+        std::unique_lock<std::recursive_mutex> lockWriter();
+
+        DatabaseHelper* acquireReader(); // 유휴 읽기 커넥션이 생길 때까지 대기
+
+        // 내보내기처럼 오래 걸리는 전체 스캔용 읽기 전용 커넥션. 풀의 읽기 커넥션을 붙잡지 않도록 따로 열고 호출 측이 소유한다.
+        // 스캔은 페이지를 다시 읽지 않으므로 페이지 캐시는 작게 둔다. WAL 이 아니면 쓰기를 막으므로 nullptr
+        std::unique_ptr<DatabaseHelper> openScanReader();
+        void releaseReader(DatabaseHelper* reader);
+        int getReaderCount() const;
+
+        // 쓰기와 모든 읽기 커넥션의 statement 캐시를 함께 켜고 끈다 (벤치마크 비교용)
+        void setStatementCacheEnabled(bool enabled);
+
+        // 모든 커넥션에 trace 를 걸어 가장 느린 capacity 개 실행을 모은다. capacity 가 0 이면 해제
+        bool setSlowQueryLog(size_t capacity, int64_t thresholdNanos);
+        std::vector<SlowQueryEntry> getSlowQueries(bool reset);
+    };
+
+    // 읽기 커넥션 대여 범위. 풀이 없으면 fallback(쓰기) 커넥션을 쓰기 잠금과 함께 사용한다.
+    class ReadConnection {
+    private:
+        ConnectionManager* manager;
+        DatabaseHelper* reader;
+        DatabaseHelper& fallback;
+        std::unique_lock<std::recursive_mutex> writerLock;
+
+    public:
+        ReadConnection(ConnectionManager* manager, DatabaseHelper& fallback);
+        ~ReadConnection();
+
+        ReadConnection(const ReadConnection&) = delete;
+        ReadConnection& operator=(const ReadConnection&) = delete;
+
+        DatabaseHelper& helper();
+    };
+
+}
+
+#endif //POCKETMONEYAPP_CONNECTIONMANAGER_H
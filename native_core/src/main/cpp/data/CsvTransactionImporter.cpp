@@ -0,0 +1,680 @@
+//
+// Created by ss on 2025-08-12.
+//
+
+#include "CsvTransactionImporter.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../domain/DateTime.h"
+#include "../platform/Log.h"
+
+#define LOG_TAG_DAL "NativeCoreDAL"
+#define LOGD_DAL(...) PLATFORM_LOGD(LOG_TAG_DAL, __VA_ARGS__)
+#define LOGE_DAL(...) PLATFORM_LOGE(LOG_TAG_DAL, __VA_ARGS__)
+
+namespace data {
+
+    namespace {
+
+        constexpr size_t DESCRIPTION_KEEP_BYTES = 256; // 재사용 슬롯이 붙잡아 둘 설명 버퍼 상한
+        constexpr size_t MAX_FIELDS = 256;             // 이보다 열이 많은 행은 거부한다
+        constexpr std::chrono::milliseconds PROGRESS_WAIT(100); // 삽입을 기다리는 동안에도 이 간격으로 진행률을 알린다
+
+        // 파서와 삽입 스레드가 주고받는 거래 묶음. rows 는 batchRows 크기로 한 번만 만들고 슬롯을 덮어쓴다
+        struct Batch {
+            std::vector<domain::Transaction> rows;
+            std::vector<int64_t> lines; // 각 행의 CSV 줄 번호 (거부 보고용)
+            size_t count = 0;
+        };
+
+        // 고정 용량 링 버퍼 큐. 묶음 풀 크기가 정해져 있으므로 가득 찰 일이 없다
+        class BatchQueue {
+        public:
+            explicit BatchQueue(size_t capacity) : slots(capacity) {}
+
+            void push(Batch* batch) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    slots[(head + count) % slots.size()] = batch;
+                    ++count;
+                }
+                ready.notify_one();
+            }
+
+            // 대기 시간 안에 꺼낼 것이 없거나 닫히고 비었으면 nullptr
+            Batch* pop(std::chrono::milliseconds wait) {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (!ready.wait_for(lock, wait, [this] { return count > 0 || closed; }) || count == 0) {
+                    return nullptr;
+                }
+                Batch* batch = slots[head];
+                head = (head + 1) % slots.size();
+                --count;
+                return batch;
+            }
+
+            Batch* pop() {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [this] { return count > 0 || closed; });
+                if (count == 0) return nullptr;
+                Batch* batch = slots[head];
+                head = (head + 1) % slots.size();
+                --count;
+                return batch;
+            }
+
+            void close() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    closed = true;
+                }
+                ready.notify_all();
+            }
+
+            bool isClosed() {
+                std::lock_guard<std::mutex> lock(mutex);
+                return closed;
+            }
+
+        private:
+            std::vector<Batch*> slots;
+            size_t head = 0;
+            size_t count = 0;
+            bool closed = false;
+            std::mutex mutex;
+            std::condition_variable ready;
+        };
+
+        // RFC 4180 상태 기계. 버퍼 경계에 걸친 필드도 이어 붙이며, 행 하나 분량(maxRecordBytes)만 들고 있는다
+        class CsvRecordParser {
+        public:
+            explicit CsvRecordParser(size_t maxRecordBytes) : maxRecordBytes(maxRecordBytes) {
+                record.reserve(1024);
+            }
+
+            // 완성된 행마다 onRecord(*this) 를 부른다. onRecord 가 false 를 돌려주면 멈추고 false
+            template<typename OnRecord>
+            bool feed(const char* p, size_t n, OnRecord&& onRecord) {
+                const char* end = p + n;
+                while (p < end) {
+                    char c = *p;
+                    switch (state) {
+                        case State::FIELD_START:
+                            if (c == '"') {
+                                state = State::QUOTED;
+                                ++p;
+                                continue;
+                            }
+                            state = State::UNQUOTED;
+                            continue;
+                        case State::UNQUOTED: {
+                            const char* start = p;
+                            while (p < end && *p != ',' && *p != '\n' && *p != '\r') ++p;
+                            append(start, p - start);
+                            if (p == end) return true;
+                            c = *p++;
+                            if (c == ',') {
+                                endField();
+                            } else if (!endRecord(c, onRecord)) {
+                                return false;
+                            }
+                            continue;
+                        }
+                        case State::QUOTED: {
+                            const char* start = p;
+                            while (p < end && *p != '"') {
+                                if (*p == '\n') ++line;
+                                ++p;
+                            }
+                            append(start, p - start);
+                            if (p == end) return true;
+                            ++p;
+                            state = State::QUOTED_QUOTE;
+                            continue;
+                        }
+                        case State::QUOTED_QUOTE:
+                            ++p;
+                            if (c == '"') {
+                                append("\"", 1); // "" -> "
+                                state = State::QUOTED;
+                            } else if (c == ',') {
+                                endField();
+                            } else if (c == '\n' || c == '\r') {
+                                if (!endRecord(c, onRecord)) return false;
+                            } else {
+                                append(&c, 1); // 닫는 따옴표 뒤의 문자는 관대하게 이어 붙인다
+                                state = State::UNQUOTED;
+                            }
+                            continue;
+                    }
+                }
+                return true;
+            }
+
+            // 마지막 줄이 개행 없이 끝난 경우
+            template<typename OnRecord>
+            bool finish(OnRecord&& onRecord) {
+                if (state == State::FIELD_START && fieldEnds.empty() && record.empty()) return true;
+                return endRecord('\n', onRecord);
+            }
+
+            size_t fieldCount() const { return fieldEnds.size(); }
+            const char* field(size_t i, size_t& length) const {
+                size_t start = i == 0 ? 0 : fieldEnds[i - 1];
+                length = fieldEnds[i] - start;
+                return record.data() + start;
+            }
+            bool overflowed() const { return overflow; }
+            int64_t recordLine() const { return startLine; }
+
+        private:
+            enum class State { FIELD_START, UNQUOTED, QUOTED, QUOTED_QUOTE };
+
+            size_t maxRecordBytes;
+            State state = State::FIELD_START;
+            std::string record;              // 현재 행의 필드 값을 이어 붙인 것
+            std::vector<size_t> fieldEnds;   // 필드별 끝 오프셋
+            bool overflow = false;
+            int64_t line = 1;
+            int64_t startLine = 1;
+
+            void append(const char* p, size_t n) {
+                if (n == 0 || overflow) return;
+                if (record.size() + n > maxRecordBytes) {
+                    overflow = true; // 행 끝까지 읽고 버린다
+                    return;
+                }
+                record.append(p, n);
+            }
+
+            void endField() {
+                if (fieldEnds.size() < MAX_FIELDS) {
+                    fieldEnds.push_back(record.size());
+                } else {
+                    overflow = true;
+                }
+                state = State::FIELD_START;
+            }
+
+            template<typename OnRecord>
+            bool endRecord(char terminator, OnRecord&& onRecord) {
+                fieldEnds.push_back(record.size());
+                // CRLF 의 LF 같은 빈 줄은 건너뛴다
+                bool blank = fieldEnds.size() == 1 && record.empty() && !overflow;
+                bool keepGoing = blank || onRecord(*this);
+                record.clear();
+                fieldEnds.clear();
+                overflow = false;
+                state = State::FIELD_START;
+                if (terminator == '\n') ++line;
+                startLine = line;
+                return keepGoing;
+            }
+        };
+
+        enum Column { COLUMN_DATE, COLUMN_DESCRIPTION, COLUMN_AMOUNT, COLUMN_TYPE, COLUMN_WALLET, COLUMN_COUNT };
+
+        void trim(const char*& p, size_t& n) {
+            while (n > 0 && (*p == ' ' || *p == '\t')) {
+                ++p;
+                --n;
+            }
+            while (n > 0 && (p[n - 1] == ' ' || p[n - 1] == '\t')) --n;
+        }
+
+        bool equalsIgnoreCase(const char* p, size_t n, const char* name) {
+            size_t i = 0;
+            for (; i < n && name[i]; ++i) {
+                char c = p[i];
+                if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+                if (c != name[i]) return false;
+            }
+            return i == n && name[i] == '\0';
+        }
+
+        int columnForHeader(const char* p, size_t n) {
+            static const struct { const char* name; int column; } aliases[] = {
+                    {"date", COLUMN_DATE}, {"transaction_date", COLUMN_DATE}, {"transactiondate", COLUMN_DATE},
+                    {"거래일시", COLUMN_DATE}, {"거래일", COLUMN_DATE}, {"날짜", COLUMN_DATE},
+                    {"description", COLUMN_DESCRIPTION}, {"memo", COLUMN_DESCRIPTION},
+                    {"내용", COLUMN_DESCRIPTION}, {"적요", COLUMN_DESCRIPTION},
+                    {"amount", COLUMN_AMOUNT}, {"금액", COLUMN_AMOUNT},
+                    {"type", COLUMN_TYPE}, {"구분", COLUMN_TYPE},
+                    {"wallet_id", COLUMN_WALLET}, {"walletid", COLUMN_WALLET},
+            };
+            trim(p, n);
+            for (const auto& alias : aliases) {
+                if (equalsIgnoreCase(p, n, alias.name)) return alias.column;
+            }
+            return -1;
+        }
+
+        // "YYYY-MM-DD", "YYYY/MM/DD HH:MM", "YYYY-MM-DDTHH:MM:SS" 등을 DateTime 형식으로 맞춘 뒤 파싱한다
+        bool parseDate(const char* p, size_t n, int64_t& epochSeconds) {
+            trim(p, n);
+            if (n != 10 && n != 16 && n != domain::DATE_TIME_LENGTH) return false;
+            char text[domain::DATE_TIME_LENGTH + 1] = "0000-00-00 00:00:00";
+            std::memcpy(text, p, n);
+            for (size_t i : {static_cast<size_t>(4), static_cast<size_t>(7)}) {
+                if (text[i] == '/' || text[i] == '.') text[i] = '-';
+            }
+            if (n > 10 && text[10] == 'T') text[10] = ' ';
+            return domain::parseDateTime(text, domain::DATE_TIME_LENGTH, epochSeconds);
+        }
+
+        bool parseAmount(const char* p, size_t n, long long& amount) {
+            trim(p, n);
+            bool negative = false;
+            if (n > 0 && (*p == '-' || *p == '+')) {
+                negative = *p == '-';
+                ++p;
+                --n;
+            }
+            if (n == 0) return false;
+            unsigned long long value = 0;
+            for (size_t i = 0; i < n; ++i) {
+                if (p[i] == ',') continue;
+                unsigned digit = static_cast<unsigned>(p[i] - '0');
+                if (digit > 9 || value > (static_cast<unsigned long long>(INT64_MAX) - digit) / 10) return false;
+                value = value * 10 + digit;
+            }
+            amount = negative ? -static_cast<long long>(value) : static_cast<long long>(value);
+            return true;
+        }
+
+        bool parseType(const char* p, size_t n, domain::TransactionType& type) {
+            trim(p, n);
+            if (equalsIgnoreCase(p, n, "0") || equalsIgnoreCase(p, n, "income") || equalsIgnoreCase(p, n, "수입")) {
+                type = domain::TransactionType::INCOME;
+                return true;
+            }
+            if (equalsIgnoreCase(p, n, "1") || equalsIgnoreCase(p, n, "expense") || equalsIgnoreCase(p, n, "지출")) {
+                type = domain::TransactionType::EXPENSE;
+                return true;
+            }
+            return false;
+        }
+
+        bool parseWalletId(const char* p, size_t n, int& walletId) {
+            trim(p, n);
+            if (n == 0 || n > 9) return false;
+            int value = 0;
+            for (size_t i = 0; i < n; ++i) {
+                unsigned digit = static_cast<unsigned>(p[i] - '0');
+                if (digit > 9) return false;
+                value = value * 10 + static_cast<int>(digit);
+            }
+            walletId = value;
+            return value > 0;
+        }
+
+        // JNI NewStringUTF 로 다시 나갈 값이므로 깨진 UTF-8 (예: 변환하지 않은 CP949 파일) 은 거부한다
+        bool isValidUtf8(const char* p, size_t n) {
+            const auto* s = reinterpret_cast<const unsigned char*>(p);
+            size_t i = 0;
+            while (i < n) {
+                unsigned char c = s[i];
+                if (c < 0x80) {
+                    ++i;
+                    continue;
+                }
+                size_t extra;
+                unsigned minimum;
+                unsigned code;
+                if ((c & 0xE0) == 0xC0) {
+                    extra = 1;
+                    minimum = 0x80;
+                    code = c & 0x1F;
+                } else if ((c & 0xF0) == 0xE0) {
+                    extra = 2;
+                    minimum = 0x800;
+                    code = c & 0x0F;
+                } else if ((c & 0xF8) == 0xF0) {
+                    extra = 3;
+                    minimum = 0x10000;
+                    code = c & 0x07;
+                } else {
+                    return false;
+                }
+                if (n - i <= extra) return false;
+                for (size_t k = 1; k <= extra; ++k) {
+                    if ((s[i + k] & 0xC0) != 0x80) return false;
+                    code = (code << 6) | (s[i + k] & 0x3F);
+                }
+                if (code < minimum || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) return false;
+                i += extra + 1;
+            }
+            return true;
+        }
+
+        bool walletExists(DatabaseHelper& helper, int walletId) {
+            sqlite3_stmt* stmt = helper.prepareCached("SELECT 1 FROM Wallets WHERE ID = ?;");
+            if (!stmt) return false;
+            sqlite3_bind_int(stmt, 1, walletId);
+            bool found = sqlite3_step(stmt) == SQLITE_ROW;
+            helper.releaseStatement(stmt);
+            return found;
+        }
+
+        // 두 스레드가 함께 보는 상태
+        struct ImportState {
+            BatchQueue filled;
+            BatchQueue free;
+            std::atomic<int64_t> rowsCommitted{0};
+            std::atomic<int64_t> rowsRejected{0};
+            std::atomic<int64_t> firstRejectedLine{0};
+            std::atomic<bool> failed{false};
+            std::atomic<bool> cancelled{false};
+
+            explicit ImportState(size_t batches) : filled(batches), free(batches) {}
+
+            void reject(int64_t line) {
+                rowsRejected.fetch_add(1);
+                int64_t first = firstRejectedLine.load();
+                while ((first == 0 || line < first) && !firstRejectedLine.compare_exchange_weak(first, line)) {}
+            }
+        };
+
+        // 묶음 안의 유효한 행을 앞으로 모으고 rows 를 그 수에 맞춘다 (없는 지갑은 거부)
+        void compactBatch(Batch& batch, ImportState& state, DatabaseHelper& writer,
+                          std::unordered_map<int, bool>& knownWallets) {
+            size_t kept = 0;
+            for (size_t i = 0; i < batch.count; ++i) {
+                int walletId = batch.rows[i].walletId;
+                auto known = knownWallets.find(walletId);
+                bool exists = known != knownWallets.end() ? known->second
+                                                          : (knownWallets[walletId] = walletExists(writer, walletId));
+                if (!exists) {
+                    state.reject(batch.lines[i]);
+                    continue;
+                }
+                if (kept != i) std::swap(batch.rows[kept], batch.rows[i]);
+                ++kept;
+            }
+            batch.count = kept;
+            batch.rows.resize(kept);
+        }
+
+        void runInserter(ImportState& state, ConnectionManager& connections, TransactionRepository& repository,
+                         size_t batchRows, int64_t commitRows) {
+            std::unordered_map<int, bool> knownWallets; // 지갑 수만큼만 자란다
+            DatabaseHelper& writer = connections.writer();
+            while (Batch* batch = state.filled.pop()) {
+                if (state.failed || state.cancelled) {
+                    state.free.push(batch); // 남은 묶음은 버린다
+                    continue;
+                }
+                // 커밋 사이에는 쓰기 잠금을 놓아 다른 쓰기(UI)가 끼어들 수 있게 한다
+                auto writeLock = connections.lockWriter();
+                ScopedTransaction tx(writer);
+                int64_t pending = 0;
+                bool ok = tx.isActive();
+                while (batch && ok) {
+                    compactBatch(*batch, state, writer, knownWallets);
+                    ok = repository.createTransactions(batch->rows);
+                    pending += static_cast<int64_t>(batch->count);
+                    batch->rows.resize(batchRows);
+                    batch->count = 0;
+                    state.free.push(batch);
+                    // 다음 묶음이 이미 와 있을 때만 같은 트랜잭션에 이어 넣는다. 파싱을 기다리며 잠금을 잡고 있지 않는다
+                    batch = pending < commitRows && !state.cancelled ? state.filled.pop(std::chrono::milliseconds(0)) : nullptr;
+                }
+                if (batch) state.free.push(batch);
+                if (!ok || state.cancelled) {
+                    if (!ok) {
+                        LOGE_DAL("[Error] CSV import insert failed after %lld committed rows.",
+                                 static_cast<long long>(state.rowsCommitted.load()));
+                        state.failed = true;
+                        state.free.close(); // 묶음을 기다리는 파서를 깨운다
+                    }
+                    continue; // tx 소멸자가 롤백
+                }
+                if (!tx.commit()) {
+                    LOGE_DAL("[Error] CSV import commit failed: %s", sqlite3_errmsg(writer.getDb()));
+                    state.failed = true;
+                    state.free.close();
+                    continue;
+                }
+                state.rowsCommitted.fetch_add(pending);
+            }
+        }
+
+    }
+
+    CsvTransactionImporter::CsvTransactionImporter(ConnectionManager& connections, TransactionRepository& repository,
+                                                   const CsvImportOptions& options)
+            : connections(connections), repository(repository), options(options) {
+        if (this->options.readBufferBytes < 4096) this->options.readBufferBytes = 4096;
+        if (this->options.batchRows < 1) this->options.batchRows = 1;
+        if (this->options.queueBatches < 1) this->options.queueBatches = 1;
+        if (this->options.commitRows < this->options.batchRows) this->options.commitRows = this->options.batchRows;
+    }
+
+    CsvImportResult CsvTransactionImporter::importFile(const std::string& path, const CsvImportProgressCallback& progress) {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            LOGE_DAL("[Error] Cannot open CSV %s: %s", path.c_str(), std::strerror(errno));
+            return CsvImportResult();
+        }
+        CsvImportResult result = importFd(fd, progress);
+        close(fd);
+        return result;
+    }
+
+    CsvImportResult CsvTransactionImporter::importFd(int fd, const CsvImportProgressCallback& progress) {
+        CsvImportResult result;
+        if (options.walletId > 0) {
+            auto writeLock = connections.lockWriter();
+            if (!walletExists(connections.writer(), options.walletId)) {
+                LOGE_DAL("[Error] CSV import target wallet %d does not exist.", options.walletId);
+                return result;
+            }
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+            result.progress.totalBytes = static_cast<int64_t>(info.st_size);
+        }
+
+        // 파서가 채우는 1개 + 삽입 스레드가 넣는 1개 + 대기열
+        const size_t batchRows = static_cast<size_t>(options.batchRows);
+        const size_t poolSize = static_cast<size_t>(options.queueBatches) + 2;
+        std::vector<Batch> pool(poolSize);
+        ImportState state(poolSize);
+        for (Batch& batch : pool) {
+            batch.rows.resize(batchRows);
+            batch.lines.resize(batchRows);
+            state.free.push(&batch);
+        }
+
+        auto report = [&] {
+            result.progress.rowsCommitted = state.rowsCommitted.load();
+            result.progress.rowsRejected = state.rowsRejected.load();
+            if (progress && !progress(result.progress)) {
+                state.cancelled = true;
+            }
+        };
+        // 빈 묶음을 얻을 때까지 기다린다. 삽입이 밀려 있는 동안에도 진행률을 알린다
+        auto acquire = [&]() -> Batch* {
+            while (!state.failed && !state.cancelled) {
+                if (Batch* batch = state.free.pop(PROGRESS_WAIT)) return batch;
+                if (state.free.isClosed()) return nullptr;
+                report();
+            }
+            return nullptr;
+        };
+
+        std::thread inserter(runInserter, std::ref(state), std::ref(connections), std::ref(repository),
+                             batchRows, static_cast<int64_t>(options.commitRows));
+
+        int columns[COLUMN_COUNT];
+        bool headerRead = false;
+        bool badHeader = false;
+        Batch* current = acquire();
+
+        auto onRecord = [&](const CsvRecordParser& record) -> bool {
+            if (!headerRead) {
+                headerRead = true;
+                std::fill(std::begin(columns), std::end(columns), -1);
+                for (size_t i = 0; i < record.fieldCount(); ++i) {
+                    size_t length;
+                    const char* name = record.field(i, length);
+                    int column = columnForHeader(name, length);
+                    if (column >= 0 && columns[column] < 0) columns[column] = static_cast<int>(i);
+                }
+                if (columns[COLUMN_DATE] < 0 || columns[COLUMN_AMOUNT] < 0 ||
+                    (options.walletId <= 0 && columns[COLUMN_WALLET] < 0)) {
+                    LOGE_DAL("[Error] CSV header is missing date, amount or wallet_id column.");
+                    badHeader = true;
+                    return false;
+                }
+                return true;
+            }
+
+            domain::Transaction& transaction = current->rows[current->count];
+            auto fieldOf = [&](int column, size_t& length) -> const char* {
+                if (columns[column] < 0 || static_cast<size_t>(columns[column]) >= record.fieldCount()) {
+                    length = 0;
+                    return "";
+                }
+                return record.field(static_cast<size_t>(columns[column]), length);
+            };
+            size_t length;
+            const char* value;
+            bool valid = !record.overflowed();
+            if (valid) {
+                value = fieldOf(COLUMN_DATE, length);
+                valid = parseDate(value, length, transaction.transactionDate);
+            }
+            if (valid) {
+                value = fieldOf(COLUMN_AMOUNT, length);
+                valid = parseAmount(value, length, transaction.amount);
+            }
+            if (valid) {
+                if (columns[COLUMN_TYPE] >= 0) {
+                    value = fieldOf(COLUMN_TYPE, length);
+                    valid = parseType(value, length, transaction.type);
+                } else {
+                    transaction.type = transaction.amount < 0 ? domain::TransactionType::EXPENSE
+                                                              : domain::TransactionType::INCOME;
+                }
+                if (transaction.amount < 0) transaction.amount = -transaction.amount;
+            }
+            if (valid) {
+                if (options.walletId > 0) {
+                    transaction.walletId = options.walletId;
+                } else {
+                    value = fieldOf(COLUMN_WALLET, length);
+                    valid = parseWalletId(value, length, transaction.walletId);
+                }
+            }
+            if (valid) {
+                value = fieldOf(COLUMN_DESCRIPTION, length);
+                trim(value, length);
+                valid = isValidUtf8(value, length);
+                if (valid) {
+                    if (transaction.description.capacity() > DESCRIPTION_KEEP_BYTES && length <= DESCRIPTION_KEEP_BYTES) {
+                        std::string().swap(transaction.description);
+                    }
+                    transaction.description.assign(value, length);
+                }
+            }
+            if (!valid) {
+                state.reject(record.recordLine());
+                return true;
+            }
+
+            transaction.id = 0;
+            current->lines[current->count] = record.recordLine();
+            ++result.progress.rowsParsed;
+            if (++current->count < batchRows) return true;
+
+            state.filled.push(current);
+            report();
+            current = acquire();
+            return current != nullptr;
+        };
+
+        CsvRecordParser parser(options.maxRecordBytes);
+        std::vector<char> buffer(options.readBufferBytes);
+        bool readFailed = false;
+        // UTF-8 BOM. 파이프는 read() 한 번에 몇 바이트만 줄 수 있으므로 앞부분이 맞는 동안 보류했다가 판단한다
+        static const char BOM[] = "\xEF\xBB\xBF";
+        const size_t bomLength = sizeof(BOM) - 1;
+        size_t bomHeld = 0;
+        bool bomChecked = false;
+        bool keepGoing = current != nullptr;
+        while (keepGoing) {
+            ssize_t n = read(fd, buffer.data(), buffer.size());
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                LOGE_DAL("[Error] CSV read failed: %s", std::strerror(errno));
+                readFailed = true;
+                break;
+            }
+            if (n == 0) {
+                if (!bomChecked && bomHeld > 0) keepGoing = parser.feed(BOM, bomHeld, onRecord);
+                keepGoing = keepGoing && parser.finish(onRecord);
+                break;
+            }
+            result.progress.bytesRead += n;
+            const char* data = buffer.data();
+            size_t size = static_cast<size_t>(n);
+            if (!bomChecked) {
+                size_t matched = 0;
+                while (matched < size && bomHeld + matched < bomLength && data[matched] == BOM[bomHeld + matched]) {
+                    ++matched;
+                }
+                if (bomHeld + matched == bomLength) {
+                    bomChecked = true;
+                    data += matched;
+                    size -= matched;
+                } else if (matched == size) {
+                    bomHeld += matched;
+                    continue;
+                } else {
+                    // BOM 이 아니다: 보류한 바이트도 데이터다
+                    bomChecked = true;
+                    if (bomHeld > 0 && !parser.feed(BOM, bomHeld, onRecord)) break;
+                }
+            }
+            keepGoing = parser.feed(data, size, onRecord);
+        }
+
+        if (current && current->count > 0 && !readFailed && !badHeader && !state.cancelled) {
+            state.filled.push(current); // 마지막 덜 찬 묶음
+        } else if (current) {
+            current->count = 0;
+            state.free.push(current);
+        }
+        if (readFailed || badHeader) state.cancelled = true; // 아직 커밋되지 않은 행은 되돌린다
+        state.filled.close();
+        inserter.join();
+
+        result.progress.rowsCommitted = state.rowsCommitted.load();
+        result.progress.rowsRejected = state.rowsRejected.load();
+        result.firstRejectedLine = state.firstRejectedLine.load();
+        result.cancelled = state.cancelled && !readFailed && !badHeader;
+        result.success = !state.failed && !state.cancelled && headerRead;
+        if (progress) progress(result.progress);
+
+        LOGD_DAL("[Info] CSV import: %lld committed, %lld rejected of %lld bytes (success %d, cancelled %d).",
+                 static_cast<long long>(result.progress.rowsCommitted), static_cast<long long>(result.progress.rowsRejected),
+                 static_cast<long long>(result.progress.bytesRead), result.success, result.cancelled);
+        return result;
+    }
+
+}
@@ -0,0 +1,70 @@
+//
+// Created by ss on 2025-08-12.
+//
+
+#ifndef POCKETMONEYAPP_CSVTRANSACTIONIMPORTER_H
+#define POCKETMONEYAPP_CSVTRANSACTIONIMPORTER_H
+
+#include "ConnectionManager.h"
+#include "TransactionRepository.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace data {
+
+    struct CsvImportOptions {
+        int walletId = 0;                    // 0 이면 파일의 wallet_id 열을 쓴다
+        size_t readBufferBytes = 64 * 1024;  // read() 한 번에 읽는 크기. 파일 크기와 무관하게 이 버퍼 하나만 쓴다
+        size_t maxRecordBytes = 64 * 1024;   // 이보다 긴 행은 거부한다 (행 버퍼 상한)
+        int batchRows = 256;                 // 파서 -> 삽입 스레드로 넘기는 묶음 크기
+        int queueBatches = 4;                // 대기 가능한 묶음 수. 삽입이 밀리면 파서가 멈춘다
+        int commitRows = 8192;               // 한 트랜잭션의 최대 행 수
+    };
+
+    struct CsvImportProgress {
+        int64_t bytesRead = 0;
+        int64_t totalBytes = -1;  // 일반 파일이 아니면 -1
+        int64_t rowsParsed = 0;
+        int64_t rowsCommitted = 0;
+        int64_t rowsRejected = 0; // 형식 오류, 없는 지갑, 너무 긴 행
+    };
+
+    struct CsvImportResult {
+        bool success = false;
+        bool cancelled = false;
+        CsvImportProgress progress;
+        int64_t firstRejectedLine = 0; // 1부터 세는 줄 번호. 거부된 행이 없으면 0
+    };
+
+    // false 를 돌려주면 가져오기를 취소한다. importFd 를 호출한 스레드에서 불린다
+    using CsvImportProgressCallback = std::function<bool(const CsvImportProgress&)>;
+
+    // UTF-8 CSV (RFC 4180) 를 스트리밍으로 읽어 거래로 넣는다.
+    // 호출 스레드가 고정 크기 버퍼로 읽고 파싱해 거래 묶음을 크기가 정해진 큐로 넘기고,
+    // 삽입 스레드가 TransactionRepository::createTransactions 로 넣으며 commitRows 마다 커밋한다.
+    // 묶음은 재사용하므로 메모리는 버퍼 + queueBatches 개 묶음으로 고정된다.
+    //
+    // 첫 행은 헤더이며 열 이름(대소문자 무시)으로 찾는다. 필수: date, amount. 선택: description, type, wallet_id.
+    //  - date: "YYYY-MM-DD[ HH:MM[:SS]]" ('/', '.' 구분자와 'T' 허용)
+    //  - amount: 정수 (부호, 천 단위 쉼표 허용). type 열이 없으면 음수는 지출, 나머지는 수입
+    //  - type: 0/1, income/expense, 수입/지출
+    // 취소되거나 실패하면 마지막 커밋 이후 행만 되돌리고 앞서 커밋된 행은 남는다.
+    class CsvTransactionImporter {
+    public:
+        CsvTransactionImporter(ConnectionManager& connections, TransactionRepository& repository,
+                               const CsvImportOptions& options = CsvImportOptions());
+
+        CsvImportResult importFile(const std::string& path, const CsvImportProgressCallback& progress = nullptr);
+        CsvImportResult importFd(int fd, const CsvImportProgressCallback& progress = nullptr); // fd 는 닫지 않는다
+
+    private:
+        ConnectionManager& connections;
+        TransactionRepository& repository;
+        CsvImportOptions options;
+    };
+
+}
+
+#endif //POCKETMONEYAPP_CSVTRANSACTIONIMPORTER_H
@@ -3,16 +3,31 @@
 //
 
 #include "DatabaseHelper.h"
-#include <android/log.h>
+#include "LatencyMetrics.h"
+#include "SchemaMigrator.h"
+#include <cstring>
+#include "../platform/Log.h"
 
 #define LOG_TAG_DAL "NativeCoreDAL"
-#define LOGD_DAL(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG_DAL, __VA_ARGS__)
-#define LOGE_DAL(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG_DAL, __VA_ARGS__)
+#define LOGD_DAL(...) PLATFORM_LOGD(LOG_TAG_DAL, __VA_ARGS__)
+#define LOGE_DAL(...) PLATFORM_LOGE(LOG_TAG_DAL, __VA_ARGS__)
 
 namespace data {
 
-    DatabaseHelper::DatabaseHelper(const std::string& path)
-            : dbPath(path), db(nullptr), isOpen(false) {}
+    OpenProfile OpenProfile::sqliteDefaults() {
+        OpenProfile defaults;
+        defaults.walJournal = false;
+        defaults.synchronousNormal = false;
+        defaults.cacheSizeKiB = 0;
+        defaults.mmapSizeBytes = 0;
+        defaults.tempStoreMemory = false;
+        defaults.busyTimeoutMs = 0;
+        return defaults;
+    }
+
+    DatabaseHelper::DatabaseHelper(const std::string& path, const OpenProfile& profile)
+            : db(nullptr), dbPath(path), profile(profile), isOpen(false), statementCacheEnabled(true),
+              slowQueryLog(nullptr) {}
 
     DatabaseHelper::~DatabaseHelper() {
         closeDatabase();
@@ -20,19 +35,55 @@ namespace data {
 
     bool DatabaseHelper::openDatabase() {
         if (isOpen) return true;
-        int rc = sqlite3_open(dbPath.c_str(), &db);
+        int flags = profile.readOnly ? SQLITE_OPEN_READONLY : (SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+        int rc = sqlite3_open_v2(dbPath.c_str(), &db, flags, nullptr);
         if (rc) {
             LOGE_DAL("[Error] DB 연결 실패: %s", sqlite3_errmsg(db));
+            sqlite3_close(db); // 실패해도 핸들이 할당될 수 있다
+            db = nullptr;
             return false;
         } else {
             LOGD_DAL("[Success] DB 연결 성공: %s", dbPath.c_str());
             isOpen = true;
+            if (!applyProfile()) {
+                closeDatabase();
+                return false;
+            }
             return true;
         }
     }
 
+    bool DatabaseHelper::applyProfile() {
+        if (profile.busyTimeoutMs > 0) {
+            sqlite3_busy_timeout(db, profile.busyTimeoutMs);
+        }
+
+        std::string pragmas;
+        // journal_mode 는 쓰기 커넥션이 정한다 (읽기 전용 커넥션에서는 변경 불가)
+        if (profile.walJournal && !profile.readOnly) pragmas += "PRAGMA journal_mode = WAL;";
+        if (profile.synchronousNormal) pragmas += "PRAGMA synchronous = NORMAL;";
+        if (profile.cacheSizeKiB > 0) pragmas += "PRAGMA cache_size = -" + std::to_string(profile.cacheSizeKiB) + ";";
+        if (profile.mmapSizeBytes > 0) pragmas += "PRAGMA mmap_size = " + std::to_string(profile.mmapSizeBytes) + ";";
+        if (profile.tempStoreMemory) pragmas += "PRAGMA temp_store = MEMORY;";
+        if (pragmas.empty()) return true;
+
+        char *errMsg = nullptr;
+        if (sqlite3_exec(db, pragmas.c_str(), 0, 0, &errMsg) != SQLITE_OK) {
+            LOGE_DAL("[SQL Error] open profile: %s", errMsg);
+            sqlite3_free(errMsg);
+            return false;
+        }
+        LOGD_DAL("[Info] Open profile applied: %s", pragmas.c_str());
+        return true;
+    }
+
     void DatabaseHelper::closeDatabase() {
         if (isOpen && db) {
+            finalizeCachedStatements();
+            sqlite3_trace_v2(db, 0, nullptr, nullptr);
+            slowQueryLog = nullptr;
+            tracedRuns.clear();
+            walletCache.invalidate();
             sqlite3_close(db);
             LOGD_DAL("[Info] DB 닫힘");
             db = nullptr;
@@ -54,7 +105,24 @@ namespace data {
                 "BALANCE INTEGER DEFAULT 0" // SQLite는 INTEGER로 충분
                 ");";
 
-        // 트랜잭션 테이블 생성 SQL 추가
+        int rc_wallet = sqlite3_exec(db, createWalletsSql, 0, 0, &errMsg);
+        if (rc_wallet != SQLITE_OK) {
+            LOGE_DAL("[SQL Error] Wallets table: %s", errMsg);
+            sqlite3_free(errMsg);
+            return false;
+        } else {
+            LOGD_DAL("[Info] Wallets table created or already exists.");
+        }
+
+        if (!createTransactionsTable()) {
+            return false;
+        }
+
+        // 인덱스, 컬럼 변경 등은 user_version 기준으로 SchemaMigrator 가 이어서 적용한다
+        return SchemaMigrator(*this).migrateSchema();
+    }
+
+    bool DatabaseHelper::createTransactionsTable() {
         const char* createTransactionsSql =
                 "CREATE TABLE IF NOT EXISTS Transactions ("
                 "ID INTEGER PRIMARY KEY AUTOINCREMENT,"
@@ -62,30 +130,236 @@ namespace data {
                 "Description TEXT,"
                 "Amount INTEGER NOT NULL," // 금액
                 "Type INTEGER NOT NULL," // 0: INCOME, 1: EXPENSE
-                "TransactionDate TEXT NOT NULL," // YYYY-MM-DD HH:MM:SS
+                "TransactionDate INTEGER NOT NULL," // epoch 초 (YYYY-MM-DD HH:MM:SS 를 UTC 로 취급)
                 "FOREIGN KEY(wallet_id) REFERENCES Wallets(ID) ON DELETE CASCADE" // 지갑 삭제 시 트랜잭션도 삭제
                 ");";
+        char *errMsg = nullptr;
+        if (sqlite3_exec(db, createTransactionsSql, 0, 0, &errMsg) != SQLITE_OK) {
+            LOGE_DAL("[SQL Error] Transactions table: %s", errMsg);
+            sqlite3_free(errMsg);
+            return false;
+        }
+        LOGD_DAL("[Info] Transactions table created or already exists.");
+        return true;
+    }
 
-        int rc_wallet = sqlite3_exec(db, createWalletsSql, 0, 0, &errMsg);
-        if (rc_wallet != SQLITE_OK) {
-            LOGE_DAL("[SQL Error] Wallets table: %s", errMsg);
+    bool DatabaseHelper::createListIndex() {
+        // 거래 목록 조회(wallet_id 조건 + 날짜/ID 역순)를 정렬 없이 인덱스만으로 처리하기 위한 커버링 인덱스
+        const char* createListIndexSql =
+                "CREATE INDEX IF NOT EXISTS idx_transactions_wallet_date ON Transactions ("
+                "wallet_id, TransactionDate DESC, ID DESC, Amount, Type, Description"
+                ");";
+        char *errMsg = nullptr;
+        if (sqlite3_exec(db, createListIndexSql, 0, 0, &errMsg) != SQLITE_OK) {
+            LOGE_DAL("[SQL Error] idx_transactions_wallet_date: %s", errMsg);
             sqlite3_free(errMsg);
             return false;
-        } else {
-            LOGD_DAL("[Info] Wallets table created or already exists.");
         }
+        return true;
+    }
 
-        int rc_transaction = sqlite3_exec(db, createTransactionsSql, 0, 0, &errMsg);
-        if (rc_transaction != SQLITE_OK) {
-            LOGE_DAL("[SQL Error] Transactions table: %s", errMsg);
+    bool DatabaseHelper::createMonthlyTotalsTable() {
+        // (wallet_id, yyyymm) 기본키 순서로 저장되어 한 지갑의 월별 추이는 범위 검색 한 번으로 읽힌다
+        const char* createMonthlyTotalsSql =
+                "CREATE TABLE IF NOT EXISTS MonthlyTotals ("
+                "wallet_id INTEGER NOT NULL,"
+                "yyyymm INTEGER NOT NULL,"
+                "income INTEGER NOT NULL DEFAULT 0,"
+                "expense INTEGER NOT NULL DEFAULT 0,"
+                "count INTEGER NOT NULL DEFAULT 0,"
+                "PRIMARY KEY (wallet_id, yyyymm)"
+                ") WITHOUT ROWID;";
+        char *errMsg = nullptr;
+        if (sqlite3_exec(db, createMonthlyTotalsSql, 0, 0, &errMsg) != SQLITE_OK) {
+            LOGE_DAL("[SQL Error] MonthlyTotals table: %s", errMsg);
             sqlite3_free(errMsg);
             return false;
-        } else {
-            LOGD_DAL("[Info] Transactions table created or already exists.");
         }
         return true;
     }
 
+    bool DatabaseHelper::createSearchIndex() {
+        // 외부 콘텐츠 FTS5: 본문은 Transactions 에만 두고 색인만 따로 저장한다. 트리거가 같은 트랜잭션에서 색인을 맞춘다.
+        // wallet_id 도 토큰으로 색인해 지갑 조건을 조인 대신 색인 교집합으로 처리한다 (순위 가중치 0).
+        // 외부 콘텐츠 색인은 없는 행을 'delete' 하면 깨지므로, 검색 색인 백필이 아직 색인하지 않은
+        // 행(ID < SchemaBackfills.Cursor)은 트리거가 건드리지 않고 백필이 나중에 넣는다.
+        // FTS5 는 문장마다 쌓인 색인을 디스크에 내리므로 대량 삽입은 여러 행을 한 문장으로 넣어야 빠르다.
+        const std::string notBackfilled = std::string("NOT EXISTS (SELECT 1 FROM SchemaBackfills WHERE Name = '") +
+                                          SEARCH_INDEX_BACKFILL + "' AND Cursor > ";
+        const std::string createSearchIndexSql =
+                "CREATE VIRTUAL TABLE IF NOT EXISTS TransactionsFts USING fts5("
+                "Description, wallet_id, content='Transactions', content_rowid='ID', tokenize='unicode61 remove_diacritics 2'"
+                ");"
+                "INSERT INTO TransactionsFts (TransactionsFts, rank) VALUES ('rank', 'bm25(1.0, 0.0)');"
+                "CREATE TRIGGER IF NOT EXISTS transactions_fts_insert AFTER INSERT ON Transactions "
+                "WHEN " + notBackfilled + "new.ID) BEGIN "
+                "INSERT INTO TransactionsFts (rowid, Description, wallet_id) VALUES (new.ID, new.Description, new.wallet_id); "
+                "END;"
+                "CREATE TRIGGER IF NOT EXISTS transactions_fts_delete AFTER DELETE ON Transactions "
+                "WHEN " + notBackfilled + "old.ID) BEGIN "
+                "INSERT INTO TransactionsFts (TransactionsFts, rowid, Description, wallet_id) VALUES ('delete', old.ID, old.Description, old.wallet_id); "
+                "END;"
+                // updateTransaction 은 모든 컬럼을 다시 쓰므로 색인된 값이 실제로 바뀐 경우만 고친다
+                "CREATE TRIGGER IF NOT EXISTS transactions_fts_update AFTER UPDATE OF Description, wallet_id ON Transactions "
+                "WHEN (old.Description IS NOT new.Description OR old.wallet_id IS NOT new.wallet_id) "
+                "AND " + notBackfilled + "old.ID) BEGIN "
+                "INSERT INTO TransactionsFts (TransactionsFts, rowid, Description, wallet_id) VALUES ('delete', old.ID, old.Description, old.wallet_id); "
+                "INSERT INTO TransactionsFts (rowid, Description, wallet_id) VALUES (new.ID, new.Description, new.wallet_id); "
+                "END;";
+        char *errMsg = nullptr;
+        if (sqlite3_exec(db, createSearchIndexSql.c_str(), 0, 0, &errMsg) != SQLITE_OK) {
+            LOGE_DAL("[SQL Error] TransactionsFts: %s", errMsg);
+            sqlite3_free(errMsg);
+            return false;
+        }
+        return true;
+    }
+
+    bool DatabaseHelper::dropSearchIndex() {
+        const char* dropSearchIndexSql =
+                "DROP TRIGGER IF EXISTS transactions_fts_insert;"
+                "DROP TRIGGER IF EXISTS transactions_fts_delete;"
+                "DROP TRIGGER IF EXISTS transactions_fts_update;"
+                "DROP TABLE IF EXISTS TransactionsFts;";
+        char *errMsg = nullptr;
+        if (sqlite3_exec(db, dropSearchIndexSql, 0, 0, &errMsg) != SQLITE_OK) {
+            LOGE_DAL("[SQL Error] drop TransactionsFts: %s", errMsg);
+            sqlite3_free(errMsg);
+            return false;
+        }
+        return true;
+    }
+
+    bool DatabaseHelper::rebuildSearchIndex() {
+        // 'rebuild' 는 Transactions 전체를 다시 읽어 색인하므로 남은 백필 범위도 함께 채워진다
+        ScopedTransaction tx(*this);
+        if (!tx.isActive() || !createSearchIndex() ||
+            !execute("INSERT INTO TransactionsFts (TransactionsFts) VALUES ('rebuild');")) {
+            return false;
+        }
+        sqlite3_stmt* stmt = prepareCached("DELETE FROM SchemaBackfills WHERE Name = ?;");
+        if (!stmt) return false;
+        sqlite3_bind_text(stmt, 1, SEARCH_INDEX_BACKFILL, -1, SQLITE_STATIC);
+        bool ok = sqlite3_step(stmt) == SQLITE_DONE;
+        releaseStatement(stmt);
+        return ok && tx.commit();
+    }
+
+    bool DatabaseHelper::setSlowQueryLog(SlowQueryLog* log) {
+        if (!db) return false;
+        unsigned mask = log ? (SQLITE_TRACE_STMT | SQLITE_TRACE_ROW | SQLITE_TRACE_PROFILE) : 0;
+        if (sqlite3_trace_v2(db, mask, log ? &DatabaseHelper::traceCallback : nullptr, log ? this : nullptr) != SQLITE_OK) {
+            LOGE_DAL("[SQL Error] sqlite3_trace_v2: %s", sqlite3_errmsg(db));
+            return false;
+        }
+        slowQueryLog = log;
+        tracedRuns.clear();
+        return true;
+    }
+
+    int DatabaseHelper::traceCallback(unsigned type, void* context, void* p, void* x) {
+        DatabaseHelper* helper = static_cast<DatabaseHelper*>(context);
+        sqlite3_stmt* stmt = static_cast<sqlite3_stmt*>(p);
+        SlowQueryLog* log = helper->slowQueryLog;
+        if (!log) return 0;
+
+        switch (type) {
+            case SQLITE_TRACE_STMT:
+                // 트리거 본문은 "-- " 주석으로 들어온다. 바깥 statement 의 행 수를 덮어쓰지 않는다
+                if (!(x && std::strncmp(static_cast<const char*>(x), "--", 2) == 0)) {
+                    helper->tracedRuns[stmt] = TracedRun{latencyTicks(), 0};
+                }
+                break;
+            case SQLITE_TRACE_ROW: {
+                // FTS5 가 내부에서 실행하는 statement 처럼 STMT 이벤트 없이 행만 오는 경우가 있다
+                auto it = helper->tracedRuns.find(stmt);
+                if (it != helper->tracedRuns.end()) {
+                    ++it->second.rows;
+                }
+                break;
+            }
+            case SQLITE_TRACE_PROFILE: {
+                // SQLite 가 넘기는 시간은 VFS 시계(밀리초 단위) 기반이라 직접 잰 값을 쓴다.
+                // STMT 이벤트 없이 끝난 실행(FTS5 내부 statement 등)은 바깥 statement 시간에 포함되므로 건너뛴다
+                auto it = helper->tracedRuns.find(stmt);
+                if (it == helper->tracedRuns.end()) break;
+                int64_t nanos = static_cast<int64_t>(ticksToNanos(latencyTicks() - it->second.startTicks));
+                int64_t rows = it->second.rows;
+                helper->tracedRuns.erase(it);
+                // 캐시된 statement 는 재사용되므로 실행마다 카운터를 읽고 0 으로 돌린다
+                int vmSteps = sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_VM_STEP, 1);
+                int fullScanSteps = sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 1);
+                int sorts = sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_SORT, 1);
+                if (!log->wouldKeep(nanos)) break;
+
+                char* expanded = sqlite3_expanded_sql(stmt);
+                const char* sql = expanded ? expanded : sqlite3_sql(stmt);
+                log->offer(SlowQueryEntry{sql ? sql : "", nanos, rows, vmSteps, fullScanSteps, sorts});
+                sqlite3_free(expanded);
+                break;
+            }
+            default:
+                break;
+        }
+        return 0;
+    }
+
+    int DatabaseHelper::getUserVersion() {
+        int version = 0;
+        sqlite3_stmt* stmt = prepareCached("PRAGMA user_version;");
+        if (!stmt) return 0;
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            version = sqlite3_column_int(stmt, 0);
+        }
+        releaseStatement(stmt);
+        return version;
+    }
+
+    bool DatabaseHelper::setUserVersion(int version) {
+        // PRAGMA 는 바인딩 파라미터를 받지 않으므로 값을 직접 넣는다
+        std::string sql = "PRAGMA user_version = " + std::to_string(version) + ";";
+        char *errMsg = nullptr;
+        if (sqlite3_exec(db, sql.c_str(), 0, 0, &errMsg) != SQLITE_OK) {
+            LOGE_DAL("[SQL Error] user_version: %s", errMsg);
+            sqlite3_free(errMsg);
+            return false;
+        }
+        return true;
+    }
+
+    bool DatabaseHelper::tableExists(const char* tableName) {
+        sqlite3_stmt* stmt = prepareCached("SELECT 1 FROM sqlite_schema WHERE type = 'table' AND name = ?;");
+        if (!stmt) return false;
+        sqlite3_bind_text(stmt, 1, tableName, -1, SQLITE_STATIC);
+        bool exists = sqlite3_step(stmt) == SQLITE_ROW;
+        releaseStatement(stmt);
+        return exists;
+    }
+
+    bool DatabaseHelper::queryUsesIndex(const char* sql, const char* indexName) {
+        if (!isOpen || !db) return false;
+
+        std::string explainSql = std::string("EXPLAIN QUERY PLAN ") + sql;
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(db, explainSql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+            LOGE_DAL("[SQL Error] EXPLAIN QUERY PLAN: %s", sqlite3_errmsg(db));
+            return false;
+        }
+
+        bool usesIndex = false;
+        bool usesTempSort = false;
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            // 컬럼: id, parent, notused, detail
+            const char* detail = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+            if (!detail) continue;
+            LOGD_DAL("[Plan] %s", detail);
+            if (std::strstr(detail, indexName)) usesIndex = true;
+            if (std::strstr(detail, "TEMP B-TREE")) usesTempSort = true;
+        }
+        sqlite3_finalize(stmt);
+        return usesIndex && !usesTempSort;
+    }
+
     int DatabaseHelper::callback(void *data, int argc, char **argv, char **azColName) {
         // SELECT 쿼리 결과 처리 (디버깅용)
         for (int i = 0; i < argc; i++) {
@@ -98,4 +372,178 @@ namespace data {
         return db;
     }
 
-}
\ No newline at end of file
+    const OpenProfile& DatabaseHelper::getProfile() const {
+        return profile;
+    }
+
+    sqlite3_stmt* DatabaseHelper::prepareCached(const char* sql) {
+        if (!isOpen || !db) {
+            LOGE_DAL("[Error] DB not open for prepareCached.");
+            return nullptr;
+        }
+
+        if (statementCacheEnabled) {
+            auto it = statementCache.find(sql);
+            if (it != statementCache.end()) {
+                sqlite3_reset(it->second);
+                sqlite3_clear_bindings(it->second);
+                return it->second;
+            }
+        }
+
+        sqlite3_stmt* stmt = nullptr;
+        int rc = sqlite3_prepare_v3(db, sql, -1, statementCacheEnabled ? SQLITE_PREPARE_PERSISTENT : 0, &stmt, nullptr);
+        if (rc != SQLITE_OK) {
+            LOGE_DAL("[SQL Error] prepare: %s", sqlite3_errmsg(db));
+            return nullptr;
+        }
+        if (statementCacheEnabled) {
+            statementCache.emplace(sql, stmt);
+        }
+        return stmt;
+    }
+
+    sqlite3_stmt* DatabaseHelper::prepareCached(const std::string& sql) {
+        return prepareCached(sql.c_str());
+    }
+
+    void DatabaseHelper::releaseStatement(sqlite3_stmt* stmt) {
+        if (!stmt) return;
+        if (statementCacheEnabled) {
+            // 캐시된 statement 는 reset 만 하여 읽기 잠금을 바로 해제
+            sqlite3_reset(stmt);
+        } else {
+            sqlite3_finalize(stmt);
+        }
+    }
+
+    void DatabaseHelper::setStatementCacheEnabled(bool enabled) {
+        if (statementCacheEnabled == enabled) return;
+        if (!enabled) {
+            finalizeCachedStatements();
+        }
+        statementCacheEnabled = enabled;
+    }
+
+    bool DatabaseHelper::isStatementCacheEnabled() const {
+        return statementCacheEnabled;
+    }
+
+    bool DatabaseHelper::execute(const char* sql) {
+        sqlite3_stmt* stmt = prepareCached(sql);
+        if (!stmt) return false;
+        int rc = sqlite3_step(stmt);
+        if (rc != SQLITE_DONE && rc != SQLITE_ROW) {
+            LOGE_DAL("[SQL Error] %s: %s", sql, sqlite3_errmsg(db));
+            releaseStatement(stmt);
+            return false;
+        }
+        releaseStatement(stmt);
+        return true;
+    }
+
+    void DatabaseHelper::finalizeCachedStatements() {
+        for (auto& entry : statementCache) {
+            sqlite3_finalize(entry.second);
+        }
+        if (!statementCache.empty()) {
+            LOGD_DAL("[Info] %zu cached statements finalized.", statementCache.size());
+        }
+        statementCache.clear();
+    }
+
+    uint64_t DatabaseHelper::getRollbackCount() const {
+        return rollbackCount.load(std::memory_order_acquire);
+    }
+
+    void DatabaseHelper::noteRollback() {
+        rollbackCount.fetch_add(1, std::memory_order_acq_rel);
+        walletCache.invalidate();
+    }
+
+    uint64_t DatabaseHelper::getOuterTransactionEnds() const {
+        return outerTransactionEnds.load(std::memory_order_acquire);
+    }
+
+    void DatabaseHelper::noteOuterTransactionEnding() {
+        outerEndSequence.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    void DatabaseHelper::noteOuterTransactionEnd() {
+        outerTransactionEnds.fetch_add(1, std::memory_order_acq_rel);
+        walletCache.endTransaction();
+        outerEndSequence.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    uint64_t DatabaseHelper::getOuterEndSequence() const {
+        return outerEndSequence.load(std::memory_order_acquire);
+    }
+
+    uint64_t DatabaseHelper::getBackfillChanges() const {
+        return backfillChanges.load(std::memory_order_acquire);
+    }
+
+    void DatabaseHelper::noteBackfillChange() {
+        backfillChanges.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    bool DatabaseHelper::inTransaction() {
+        return db && sqlite3_get_autocommit(db) == 0;
+    }
+
+    WalletCache& DatabaseHelper::getWalletCache() {
+        return walletCache;
+    }
+
+    ScopedTransaction::ScopedTransaction(DatabaseHelper& helper)
+            : dbHelper(helper), active(false), nested(false), ending(false) {
+        sqlite3* db = dbHelper.getDb();
+        if (!db) {
+            LOGE_DAL("[Error] DB not open for transaction.");
+            return;
+        }
+        nested = sqlite3_get_autocommit(db) == 0;
+        // 쓰기 잠금을 처음부터 잡아 중간에 SQLITE_BUSY 로 실패하지 않게 한다
+        active = dbHelper.execute(nested ? "SAVEPOINT nested_tx;" : "BEGIN IMMEDIATE;");
+        if (active && !nested) {
+            dbHelper.getWalletCache().beginTransaction();
+        }
+    }
+
+    ScopedTransaction::~ScopedTransaction() {
+        if (!active) return;
+        if (nested) {
+            dbHelper.execute("ROLLBACK TO nested_tx;");
+            dbHelper.execute("RELEASE nested_tx;");
+            dbHelper.noteRollback();
+        } else {
+            if (!ending) dbHelper.noteOuterTransactionEnding();
+            dbHelper.execute("ROLLBACK;");
+            // 바깥 트랜잭션이 끝난 것을 본 쪽이 롤백도 함께 보도록 롤백 횟수를 먼저 올린다
+            dbHelper.noteRollback();
+            dbHelper.noteOuterTransactionEnd();
+        }
+        LOGD_DAL("[Info] Transaction rolled back.");
+    }
+
+    bool ScopedTransaction::isActive() const {
+        return active;
+    }
+
+    bool ScopedTransaction::commit() {
+        if (!active) return false;
+        if (!nested && !ending) {
+            ending = true;
+            dbHelper.noteOuterTransactionEnding();
+        }
+        if (!dbHelper.execute(nested ? "RELEASE nested_tx;" : "COMMIT;")) {
+            return false; // 소멸자에서 롤백
+        }
+        active = false;
+        if (!nested) {
+            dbHelper.noteOuterTransactionEnd();
+        }
+        return true;
+    }
+
+}
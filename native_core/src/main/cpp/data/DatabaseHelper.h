@@ -6,26 +6,138 @@
 #define POCKETMONEYAPP_DATABASEHELPER_H
 
 #include "../sqlite3.h"
+#include "SlowQueryLog.h"
+#include "WalletCache.h"
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 
 namespace data {
 
+    // openDatabase 직후 적용되는 PRAGMA 설정
+    struct OpenProfile {
+        bool walJournal = true;                        // journal_mode=WAL: 쓰기 중에도 읽기가 막히지 않음
+        bool synchronousNormal = true;                 // synchronous=NORMAL: WAL 에서는 커밋마다 fsync 하지 않아도 안전
+        int cacheSizeKiB = 8 * 1024;                   // cache_size=-N (0 이면 SQLite 기본값)
+        long long mmapSizeBytes = 64LL * 1024 * 1024;  // mmap_size (0 이면 사용 안 함)
+        bool tempStoreMemory = true;                   // temp_store=MEMORY
+        int busyTimeoutMs = 5000;                      // busy_timeout (0 이면 설정 안 함)
+        bool readOnly = false;                         // SQLITE_OPEN_READONLY 로 연다 (읽기 전용 풀 커넥션)
+
+        static OpenProfile sqliteDefaults(); // 튜닝 없는 SQLite 기본 설정 (비교용)
+    };
+
     class DatabaseHelper {
+    public:
+        static constexpr int SCHEMA_VERSION = 4; // PRAGMA user_version
+        static constexpr const char* SEARCH_INDEX_BACKFILL = "transactions_search"; // 검색 색인 백필 (SchemaBackfills.Name)
+
     private:
         sqlite3 *db;
         std::string dbPath;
+        OpenProfile profile;
         bool isOpen;
+        bool statementCacheEnabled;
+        std::unordered_map<std::string, sqlite3_stmt*> statementCache; // SQL 텍스트 -> 준비된 statement
+        SlowQueryLog* slowQueryLog;                                   // nullptr 이면 trace 미등록
+        struct TracedRun {
+            uint64_t startTicks; // latencyTicks() 기준 첫 step 시각
+            int64_t rows;        // 지금까지 반환된 행 수
+        };
+        std::unordered_map<sqlite3_stmt*, TracedRun> tracedRuns; // 실행 중인 statement
+        std::atomic<uint64_t> rollbackCount{0};                     // ScopedTransaction 이 되돌린 횟수
+        std::atomic<uint64_t> outerTransactionEnds{0};              // 가장 바깥 ScopedTransaction 이 끝난 횟수
+        std::atomic<uint64_t> outerEndSequence{0};                  // 바깥 COMMIT/ROLLBACK 을 실행하는 동안 홀수
+        std::atomic<uint64_t> backfillChanges{0};                   // Transactions 를 바꾼 백필 묶음이 커밋된 횟수
+        WalletCache walletCache;                                    // 쓰기 커넥션에서만 채워진다
+
+        void finalizeCachedStatements();
+        bool applyProfile();
 
     public:
-        DatabaseHelper(const std::string& path);
+        explicit DatabaseHelper(const std::string& path, const OpenProfile& profile = OpenProfile());
         ~DatabaseHelper();
 
         bool openDatabase();
         void closeDatabase();
-        bool createTables(); // Wallet, Transaction 테이블 생성
+        bool createTables(); // Wallet, Transaction 테이블 생성 후 스키마 마이그레이션 적용
+        bool createTransactionsTable(); // 최신 형식의 Transactions 테이블 (마이그레이션의 테이블 재구성에도 사용)
+        bool createListIndex(); // 거래 목록용 커버링 인덱스 idx_transactions_wallet_date 생성 (대량 적재 후 재생성에도 사용)
+        bool createMonthlyTotalsTable(); // 지갑별 월 합계 MonthlyTotals (TransactionRepository 가 같은 트랜잭션에서 갱신)
+        bool createSearchIndex(); // Description 전문 검색용 FTS5 테이블 TransactionsFts 와 동기화 트리거
+        bool dropSearchIndex(); // 대량 적재 전에 색인과 트리거를 내린다
+        bool rebuildSearchIndex(); // 색인을 다시 만들고 Transactions 전체를 한 번에 색인한다 (남은 백필도 끝낸다)
+        int getUserVersion(); // PRAGMA user_version
+        bool setUserVersion(int version);
+        bool tableExists(const char* tableName);
         sqlite3* getDb(); // SQLite 인스턴스 반환
+        const OpenProfile& getProfile() const;
+
+        // SQL 텍스트로 캐시된 statement 를 reset + 바인딩 초기화 상태로 반환 (실패 시 nullptr)
+        sqlite3_stmt* prepareCached(const char* sql);
+        sqlite3_stmt* prepareCached(const std::string& sql);
+        // prepareCached 로 받은 statement 반환: 캐시 사용 시 reset, 아니면 finalize
+        void releaseStatement(sqlite3_stmt* stmt);
+
+        void setStatementCacheEnabled(bool enabled); // 벤치마크 비교용
+        bool isStatementCacheEnabled() const;
+
+        bool execute(const char* sql); // 결과 행이 없는 단일 SQL 실행 (캐시 사용)
+
+        // 트랜잭션/SAVEPOINT 가 롤백될 때마다 증가한다. 커밋된 변경을 메모리에 반영해 두는 캐시가
+        // 바깥 트랜잭션의 롤백으로 되돌려진 변경을 알아차리는 데 쓴다
+        uint64_t getRollbackCount() const;
+        void noteRollback(); // 지갑 캐시도 함께 비운다
+
+        // 가장 바깥 트랜잭션이 커밋/롤백으로 끝날 때마다 증가한다. 안쪽 SAVEPOINT 커밋은 아직 다른 커넥션에 보이지 않으므로,
+        // 읽기 커넥션 결과를 담아 두는 캐시는 이 값이 바뀐 뒤에 한 번 더 무효화한다.
+        // 롤백으로 끝날 때는 getRollbackCount() 가 먼저 증가한다
+        uint64_t getOuterTransactionEnds() const;
+        void noteOuterTransactionEnding(); // 바깥 COMMIT/ROLLBACK 직전
+        void noteOuterTransactionEnd();    // 끝난 뒤 (getOuterTransactionEnds 를 올리고 지갑 캐시의 커밋 전 표시를 푼 다음 시퀀스를 짝수로 되돌린다)
+
+        // 읽기 커넥션 결과와 커밋 뒤에 반영되는 메모리 색인을 함께 쓰는 조회는 앞뒤로 이 값을 읽는다.
+        // 같은 짝수 값이면 그 사이 바깥 트랜잭션이 끝나지 않았으므로 둘이 같은 커밋을 본다
+        uint64_t getOuterEndSequence() const;
+
+        // 백필은 리포지토리를 거치지 않고 SQL 로 Transactions 를 옮기므로, 읽기 결과를 담아 두는 캐시는
+        // 이 값이 바뀌면 통째로 비운다. SchemaMigrator 가 그런 묶음을 커밋한 뒤 올린다
+        uint64_t getBackfillChanges() const;
+        void noteBackfillChange();
+        bool inTransaction(); // 이 커넥션에 열린 트랜잭션이 있는지 (커넥션을 쓰는 스레드에서 호출)
+
+        // Wallets 의 write-through 캐시. Wallets 를 바꾸는 코드는 같은 변경을 여기에 반영하거나 invalidate 한다
+        WalletCache& getWalletCache();
+
+        // EXPLAIN QUERY PLAN 결과에 indexName 사용이 포함되고 임시 정렬이 없으면 true
+        bool queryUsesIndex(const char* sql, const char* indexName);
+
+        // sqlite3_trace_v2(STMT | ROW | PROFILE) 를 등록해 느린 실행을 log 에 기록한다. nullptr 이면 해제
+        bool setSlowQueryLog(SlowQueryLog* log);
 
         static int callback(void *data, int argc, char **argv, char **azColName);
+        static int traceCallback(unsigned type, void* context, void* p, void* x);
+    };
+
+    // 하나의 SQLite 트랜잭션 범위. 이미 트랜잭션 안이면 SAVEPOINT 로 중첩된다.
+    // commit() 하지 않고 소멸되면 롤백한다.
+    class ScopedTransaction {
+    private:
+        DatabaseHelper& dbHelper;
+        bool active;
+        bool nested;
+        bool ending; // 바깥 COMMIT 을 시도했다 (실패하면 소멸자가 같은 종료로 롤백한다)
+
+    public:
+        explicit ScopedTransaction(DatabaseHelper& helper);
+        ~ScopedTransaction();
+
+        ScopedTransaction(const ScopedTransaction&) = delete;
+        ScopedTransaction& operator=(const ScopedTransaction&) = delete;
+
+        bool isActive() const;
+        bool commit();
     };
 
 }
@@ -0,0 +1,152 @@
+//
+// Created by ss on 2025-08-09.
+//
+
+#include "LatencyMetrics.h"
+#include <thread>
+
+namespace data {
+
+    LatencyHistogram LatencyMetrics::histograms[static_cast<int>(Operation::COUNT)];
+    std::atomic<bool> LatencyMetrics::enabled{true};
+
+    const char* operationName(Operation operation) {
+        switch (operation) {
+            case Operation::CREATE_WALLET: return "createWallet";
+            case Operation::GET_WALLET_BY_ID: return "getWalletById";
+            case Operation::GET_ALL_WALLETS: return "getAllWallets";
+            case Operation::UPDATE_WALLET: return "updateWallet";
+            case Operation::DELETE_WALLET: return "deleteWallet";
+            case Operation::RECALCULATE_BALANCE: return "recalculateBalance";
+            case Operation::VERIFY_BALANCE: return "verifyBalance";
+            case Operation::CREATE_TRANSACTION: return "createTransaction";
+            case Operation::CREATE_TRANSACTIONS: return "createTransactions";
+            case Operation::GET_TRANSACTION_BY_ID: return "getTransactionById";
+            case Operation::GET_TRANSACTIONS_BY_WALLET: return "getTransactionsByWallet";
+            case Operation::GET_TRANSACTIONS_BY_WALLET_ID: return "getTransactionsByWalletId";
+            case Operation::GET_TRANSACTIONS_PAGE: return "getTransactionsPage";
+            case Operation::SCAN_TRANSACTIONS_PAGE: return "scanTransactionsPage";
+            case Operation::UPDATE_TRANSACTION: return "updateTransaction";
+            case Operation::DELETE_TRANSACTION: return "deleteTransaction";
+            case Operation::GET_MONTHLY_TOTALS: return "getMonthlyTotals";
+            case Operation::REBUILD_MONTHLY_TOTALS: return "rebuildMonthlyTotals";
+            case Operation::BALANCE_AT: return "balanceAt";
+            case Operation::SEARCH_TRANSACTIONS: return "searchTransactions";
+            case Operation::COUNT: break;
+        }
+        return "unknown";
+    }
+
+#if defined(__aarch64__)
+    static double readNanosPerTick() {
+        uint64_t frequency;
+        asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+        return frequency > 0 ? 1e9 / static_cast<double>(frequency) : 1.0;
+    }
+
+    uint64_t ticksToNanos(uint64_t ticks) {
+        static const double nanosPerTick = readNanosPerTick();
+        return static_cast<uint64_t>(static_cast<double>(ticks) * nanosPerTick);
+    }
+#elif defined(__x86_64__) || defined(__i386__)
+    // TSC 주파수는 사용자 공간에서 바로 읽을 수 없으므로 steady_clock 과 나란히 약 2ms 를 재서 배율을 구한다
+    static double readNanosPerTick() {
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point start = Clock::now();
+        uint64_t startTicks = __rdtsc();
+        Clock::time_point end = start;
+        while (end - start < std::chrono::milliseconds(2)) {
+            std::this_thread::yield();
+            end = Clock::now();
+        }
+        uint64_t ticks = __rdtsc() - startTicks;
+        double nanos = std::chrono::duration<double, std::nano>(end - start).count();
+        return ticks > 0 ? nanos / static_cast<double>(ticks) : 1.0;
+    }
+
+    uint64_t ticksToNanos(uint64_t ticks) {
+        static const double nanosPerTick = readNanosPerTick();
+        return static_cast<uint64_t>(static_cast<double>(ticks) * nanosPerTick);
+    }
+#else
+    uint64_t ticksToNanos(uint64_t ticks) {
+        return ticks;
+    }
+#endif
+
+    int LatencyHistogram::bucketIndex(uint64_t nanos) {
+        // 0..63 은 1ns 단위, 그 위로는 구간마다 상위 6비트로 칸을 정한다
+        if (nanos < 2 * SUB_BUCKETS) return static_cast<int>(nanos);
+        int msb = 63 - __builtin_clzll(nanos);
+        int shift = msb - SUB_BUCKET_BITS;
+        if (shift > MAX_SHIFT) return BUCKET_COUNT - 1;
+        return SUB_BUCKETS * shift + static_cast<int>(nanos >> shift);
+    }
+
+    uint64_t LatencyHistogram::bucketUpperBound(int index) {
+        if (index < 2 * SUB_BUCKETS) return static_cast<uint64_t>(index);
+        int shift = index / SUB_BUCKETS - 1;
+        uint64_t quotient = static_cast<uint64_t>(index - SUB_BUCKETS * shift);
+        return ((quotient + 1) << shift) - 1;
+    }
+
+    void LatencyHistogram::record(uint64_t nanos) {
+        buckets[bucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+        uint64_t currentMax = maxNanos.load(std::memory_order_relaxed);
+        while (nanos > currentMax &&
+               !maxNanos.compare_exchange_weak(currentMax, nanos, std::memory_order_relaxed)) {
+        }
+    }
+
+    LatencyStats LatencyHistogram::snapshot(Operation operation, bool reset) {
+        uint64_t counts[BUCKET_COUNT];
+        uint64_t total = 0;
+        for (int i = 0; i < BUCKET_COUNT; ++i) {
+            counts[i] = reset ? buckets[i].exchange(0, std::memory_order_relaxed)
+                              : buckets[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+        uint64_t max = reset ? maxNanos.exchange(0, std::memory_order_relaxed)
+                             : maxNanos.load(std::memory_order_relaxed);
+
+        LatencyStats stats{operation, total, 0, 0, 0, max};
+        if (total == 0) return stats;
+
+        // 백분위 순위(1부터)에 처음 도달하는 칸의 상한값. 최댓값보다 크게 보고하지 않는다
+        const double quantiles[3] = {0.50, 0.95, 0.99};
+        uint64_t* targets[3] = {&stats.p50Nanos, &stats.p95Nanos, &stats.p99Nanos};
+        int next = 0;
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKET_COUNT && next < 3; ++i) {
+            seen += counts[i];
+            while (next < 3 && seen >= static_cast<uint64_t>(quantiles[next] * total + 0.5) && seen > 0) {
+                uint64_t bound = bucketUpperBound(i);
+                *targets[next] = (max > 0 && bound > max) ? max : bound;
+                ++next;
+            }
+        }
+        return stats;
+    }
+
+    LatencyHistogram& LatencyMetrics::histogram(Operation operation) {
+        return histograms[static_cast<int>(operation)];
+    }
+
+    std::vector<LatencyStats> LatencyMetrics::snapshot(bool reset) {
+        std::vector<LatencyStats> result;
+        for (int i = 0; i < static_cast<int>(Operation::COUNT); ++i) {
+            LatencyStats stats = histograms[i].snapshot(static_cast<Operation>(i), reset);
+            if (stats.count > 0) result.push_back(stats);
+        }
+        return result;
+    }
+
+    void LatencyMetrics::setEnabled(bool value) {
+        enabled.store(value, std::memory_order_relaxed);
+    }
+
+    bool LatencyMetrics::isEnabled() {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+}
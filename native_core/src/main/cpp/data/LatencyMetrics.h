@@ -0,0 +1,127 @@
+//
+// Created by ss on 2025-08-09.
+//
+
+#ifndef POCKETMONEYAPP_LATENCYMETRICS_H
+#define POCKETMONEYAPP_LATENCYMETRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace data {
+
+    // 계측 대상 리포지토리 연산
+    enum class Operation {
+        CREATE_WALLET,
+        GET_WALLET_BY_ID,
+        GET_ALL_WALLETS,
+        UPDATE_WALLET,
+        DELETE_WALLET,
+        RECALCULATE_BALANCE,
+        VERIFY_BALANCE,
+        CREATE_TRANSACTION,
+        CREATE_TRANSACTIONS,
+        GET_TRANSACTION_BY_ID,
+        GET_TRANSACTIONS_BY_WALLET,
+        GET_TRANSACTIONS_BY_WALLET_ID,
+        GET_TRANSACTIONS_PAGE,
+        SCAN_TRANSACTIONS_PAGE,
+        UPDATE_TRANSACTION,
+        DELETE_TRANSACTION,
+        GET_MONTHLY_TOTALS,
+        REBUILD_MONTHLY_TOTALS,
+        BALANCE_AT,
+        SEARCH_TRANSACTIONS,
+        COUNT
+    };
+
+    const char* operationName(Operation operation);
+
+    struct LatencyStats {
+        Operation operation;
+        uint64_t count;
+        uint64_t p50Nanos;
+        uint64_t p95Nanos;
+        uint64_t p99Nanos;
+        uint64_t maxNanos;
+    };
+
+    // HDR 방식의 로그-선형 히스토그램. 2의 거듭제곱 구간마다 32칸으로 나눠 상대 오차 약 3% 이내로 기록한다.
+    // record 는 원자적 증가 한두 번뿐이라 잠금 없이 여러 스레드에서 동시에 호출해도 된다.
+    class LatencyHistogram {
+    public:
+        static constexpr int SUB_BUCKET_BITS = 5;
+        static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+        static constexpr int MAX_SHIFT = 35;                                  // 2^41 ns (약 36분) 까지
+        static constexpr int BUCKET_COUNT = SUB_BUCKETS * (MAX_SHIFT + 2);
+
+        void record(uint64_t nanos);
+        LatencyStats snapshot(Operation operation, bool reset); // reset 이면 읽으면서 0 으로 비운다
+
+        static int bucketIndex(uint64_t nanos);
+        static uint64_t bucketUpperBound(int index); // 해당 칸에 들어가는 가장 큰 값
+
+    private:
+        std::atomic<uint64_t> buckets[BUCKET_COUNT] = {};
+        std::atomic<uint64_t> maxNanos{0};
+    };
+
+    // 연산별 히스토그램 모음 (프로세스 전역)
+    class LatencyMetrics {
+    public:
+        static LatencyHistogram& histogram(Operation operation);
+        static std::vector<LatencyStats> snapshot(bool reset); // 호출 기록이 있는 연산만
+
+        static void setEnabled(bool enabled);
+        static bool isEnabled();
+
+    private:
+        static LatencyHistogram histograms[static_cast<int>(Operation::COUNT)];
+        static std::atomic<bool> enabled;
+    };
+
+    // 타이머용 단조 증가 틱. arm64 에서는 가상 카운터(cntvct_el0)를, x86 (에뮬레이터, 호스트 빌드)에서는 TSC 를
+    // 직접 읽어 clock_gettime 호출을 피한다. TSC 는 constant_tsc 를 가정하고 첫 변환 때 steady_clock 으로 배율을 잰다.
+    // 그 밖의 아키텍처(armeabi-v7a)는 steady_clock 을 그대로 쓴다
+    inline uint64_t latencyTicks() {
+#if defined(__aarch64__)
+        uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#elif defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    uint64_t ticksToNanos(uint64_t ticks);
+
+    // 범위를 벗어날 때 경과 시간을 해당 연산 히스토그램에 기록한다
+    class ScopedLatencyTimer {
+    public:
+        explicit ScopedLatencyTimer(Operation operation)
+                : operation(operation), start(LatencyMetrics::isEnabled() ? latencyTicks() : 0) {}
+
+        ~ScopedLatencyTimer() {
+            if (start == 0) return;
+            LatencyMetrics::histogram(operation).record(ticksToNanos(latencyTicks() - start));
+        }
+
+        ScopedLatencyTimer(const ScopedLatencyTimer&) = delete;
+        ScopedLatencyTimer& operator=(const ScopedLatencyTimer&) = delete;
+
+    private:
+        Operation operation;
+        uint64_t start; // 0 이면 계측 꺼짐
+    };
+
+}
+
+#endif //POCKETMONEYAPP_LATENCYMETRICS_H
@@ -0,0 +1,176 @@
+//
+// Created by ss on 2025-08-12.
+//
+
+#include "MonthlyTotals.h"
+#include "../domain/DateTime.h"
+#include "../domain/Transaction.h"
+#include <algorithm>
+#include "../platform/Log.h"
+
+#define LOG_TAG_DAL "NativeCoreDAL"
+#define LOGE_DAL(...) PLATFORM_LOGE(LOG_TAG_DAL, __VA_ARGS__)
+
+namespace data {
+
+    namespace {
+
+        const char* const UPSERT_SQL =
+                "INSERT INTO MonthlyTotals (wallet_id, yyyymm, income, expense, count) VALUES (?, ?, ?, ?, ?) "
+                "ON CONFLICT (wallet_id, yyyymm) DO UPDATE SET income = income + excluded.income, "
+                "expense = expense + excluded.expense, count = count + excluded.count RETURNING count;";
+
+        const char* const INSERT_SQL =
+                "INSERT INTO MonthlyTotals (wallet_id, yyyymm, income, expense, count) VALUES (?, ?, ?, ?, ?);";
+
+        uint64_t totalKey(int walletId, int yyyymm) {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(walletId)) << 32) | static_cast<uint32_t>(yyyymm);
+        }
+
+        void bindTotal(sqlite3_stmt* stmt, const MonthlyTotal& total) {
+            sqlite3_bind_int(stmt, 1, total.walletId);
+            sqlite3_bind_int(stmt, 2, total.yyyymm);
+            sqlite3_bind_int64(stmt, 3, total.income);
+            sqlite3_bind_int64(stmt, 4, total.expense);
+            sqlite3_bind_int64(stmt, 5, total.count);
+        }
+
+        // 결과 행을 끝까지 읽어 out 에 더한다. 컬럼은 (wallet_id,) Type, Amount, TransactionDate 순
+        bool accumulateRows(DatabaseHelper& helper, sqlite3_stmt* stmt, int walletId, MonthlyTotalsAccumulator& out, int& rows) {
+            int first = walletId > 0 ? 0 : 1;
+            int rc;
+            while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+                out.add(walletId > 0 ? walletId : sqlite3_column_int(stmt, 0),
+                        sqlite3_column_int64(stmt, first + 2),
+                        sqlite3_column_int(stmt, first),
+                        sqlite3_column_int64(stmt, first + 1));
+                ++rows;
+            }
+            if (rc != SQLITE_DONE) {
+                LOGE_DAL("[SQL Error] monthly totals scan: %s", sqlite3_errmsg(helper.getDb()));
+                return false;
+            }
+            return true;
+        }
+
+    }
+
+    void MonthlyTotalsAccumulator::add(int walletId, int64_t transactionDate, int type, long long amount, int sign) {
+        int yyyymm = domain::yearMonth(transactionDate);
+        MonthlyTotal& total = totals[totalKey(walletId, yyyymm)];
+        total.walletId = walletId;
+        total.yyyymm = yyyymm;
+        if (type == static_cast<int>(domain::TransactionType::INCOME)) {
+            total.income += sign * amount;
+        } else {
+            total.expense += sign * amount;
+        }
+        total.count += sign;
+    }
+
+    void MonthlyTotalsAccumulator::merge(const MonthlyTotalsAccumulator& other) {
+        for (const auto& entry : other.totals) {
+            MonthlyTotal& total = totals[entry.first];
+            total.walletId = entry.second.walletId;
+            total.yyyymm = entry.second.yyyymm;
+            total.income += entry.second.income;
+            total.expense += entry.second.expense;
+            total.count += entry.second.count;
+        }
+    }
+
+    std::vector<MonthlyTotal> MonthlyTotalsAccumulator::sorted() const {
+        std::vector<MonthlyTotal> result;
+        result.reserve(totals.size());
+        for (const auto& entry : totals) {
+            const MonthlyTotal& total = entry.second;
+            if (total.income == 0 && total.expense == 0 && total.count == 0) continue; // 같은 달 안의 상쇄
+            result.push_back(total);
+        }
+        std::sort(result.begin(), result.end(), [](const MonthlyTotal& a, const MonthlyTotal& b) {
+            return a.walletId != b.walletId ? a.walletId < b.walletId : a.yyyymm < b.yyyymm;
+        });
+        return result;
+    }
+
+    bool applyMonthlyTotals(DatabaseHelper& helper, const MonthlyTotalsAccumulator& deltas) {
+        for (const MonthlyTotal& delta : deltas.sorted()) {
+            sqlite3_stmt* stmt = helper.prepareCached(UPSERT_SQL);
+            if (!stmt) return false;
+            bindTotal(stmt, delta);
+            bool ok = sqlite3_step(stmt) == SQLITE_ROW;
+            long long count = ok ? sqlite3_column_int64(stmt, 0) : 0;
+            ok = ok && sqlite3_step(stmt) == SQLITE_DONE;
+            helper.releaseStatement(stmt);
+            if (!ok) {
+                LOGE_DAL("[SQL Error] monthly totals upsert: %s", sqlite3_errmsg(helper.getDb()));
+                return false;
+            }
+            if (count > 0) continue;
+
+            // 마지막 거래가 빠진 달은 행을 지워 월별 추이에 빈 달이 남지 않게 한다
+
+            stmt = helper.prepareCached("DELETE FROM MonthlyTotals WHERE wallet_id = ? AND yyyymm = ?;");
+            if (!stmt) return false;
+            sqlite3_bind_int(stmt, 1, delta.walletId);
+            sqlite3_bind_int(stmt, 2, delta.yyyymm);
+            ok = sqlite3_step(stmt) == SQLITE_DONE;
+            helper.releaseStatement(stmt);
+            if (!ok) {
+                LOGE_DAL("[SQL Error] monthly totals prune: %s", sqlite3_errmsg(helper.getDb()));
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool accumulateMonthlyTotals(DatabaseHelper& helper, int64_t firstId, int64_t lastId, MonthlyTotalsAccumulator& out) {
+        sqlite3_stmt* stmt = helper.prepareCached(
+                "SELECT wallet_id, Type, Amount, TransactionDate FROM Transactions WHERE ID BETWEEN ? AND ?;");
+        if (!stmt) return false;
+        sqlite3_bind_int64(stmt, 1, firstId);
+        sqlite3_bind_int64(stmt, 2, lastId);
+        int rows = 0;
+        bool ok = accumulateRows(helper, stmt, 0, out, rows);
+        helper.releaseStatement(stmt);
+        return ok;
+    }
+
+    bool accumulateWalletMonthlyTotals(DatabaseHelper& helper, int walletId, MonthlyTotalsAccumulator& out, int& rows) {
+        sqlite3_stmt* stmt = helper.prepareCached(
+                "SELECT Type, Amount, TransactionDate FROM Transactions WHERE wallet_id = ?;");
+        if (!stmt) return false;
+        sqlite3_bind_int(stmt, 1, walletId);
+        bool ok = accumulateRows(helper, stmt, walletId, out, rows);
+        helper.releaseStatement(stmt);
+        return ok;
+    }
+
+    bool replaceMonthlyTotals(DatabaseHelper& helper, int walletId, const MonthlyTotalsAccumulator& totals) {
+        sqlite3_stmt* stmt = helper.prepareCached(walletId > 0 ? "DELETE FROM MonthlyTotals WHERE wallet_id = ?;"
+                                                               : "DELETE FROM MonthlyTotals;");
+        if (!stmt) return false;
+        if (walletId > 0) sqlite3_bind_int(stmt, 1, walletId);
+        bool ok = sqlite3_step(stmt) == SQLITE_DONE;
+        helper.releaseStatement(stmt);
+        if (!ok) {
+            LOGE_DAL("[SQL Error] monthly totals clear: %s", sqlite3_errmsg(helper.getDb()));
+            return false;
+        }
+
+        // 키 순서대로 넣어 WITHOUT ROWID B-tree 의 페이지 분할을 줄인다
+        for (const MonthlyTotal& total : totals.sorted()) {
+            stmt = helper.prepareCached(INSERT_SQL);
+            if (!stmt) return false;
+            bindTotal(stmt, total);
+            ok = sqlite3_step(stmt) == SQLITE_DONE;
+            helper.releaseStatement(stmt);
+            if (!ok) {
+                LOGE_DAL("[SQL Error] monthly totals insert: %s", sqlite3_errmsg(helper.getDb()));
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
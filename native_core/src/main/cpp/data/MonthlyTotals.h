@@ -0,0 +1,53 @@
+//
+// Created by ss on 2025-08-12.
+//
+
+#ifndef POCKETMONEYAPP_MONTHLYTOTALS_H
+#define POCKETMONEYAPP_MONTHLYTOTALS_H
+
+#include "DatabaseHelper.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace data {
+
+    // MonthlyTotals 한 행. 증감분을 나타낼 때는 값이 음수일 수 있다
+    struct MonthlyTotal {
+        int walletId = 0;
+        int yyyymm = 0;
+        long long income = 0;
+        long long expense = 0;
+        long long count = 0;
+    };
+
+    // (wallet_id, yyyymm) 별 합계를 메모리에 모은다.
+    // 일괄 삽입/수정의 증감분을 묶거나 재계산 결과를 나눠 모은 뒤 합치는 데 쓴다.
+    class MonthlyTotalsAccumulator {
+    private:
+        std::unordered_map<uint64_t, MonthlyTotal> totals;
+
+    public:
+        // sign 이 -1 이면 해당 거래를 빼는 증감분
+        void add(int walletId, int64_t transactionDate, int type, long long amount, int sign = 1);
+        void merge(const MonthlyTotalsAccumulator& other);
+
+        bool empty() const { return totals.empty(); }
+        std::vector<MonthlyTotal> sorted() const; // (walletId, yyyymm) 순. 변화 없는 항목은 뺀다
+    };
+
+    // 호출 측 트랜잭션 안에서 증감분을 반영한다. 건수가 0 이 된 달은 지운다
+    bool applyMonthlyTotals(DatabaseHelper& helper, const MonthlyTotalsAccumulator& deltas);
+
+    // Transactions 의 ID 범위 [firstId, lastId] 를 읽어 더한다
+    bool accumulateMonthlyTotals(DatabaseHelper& helper, int64_t firstId, int64_t lastId, MonthlyTotalsAccumulator& out);
+
+    // 한 지갑의 거래를 (커버링 인덱스로) 읽어 더한다. rows 에 읽은 행 수를 더한다
+    bool accumulateWalletMonthlyTotals(DatabaseHelper& helper, int walletId, MonthlyTotalsAccumulator& out, int& rows);
+
+    // walletId 가 0 이하이면 전체, 아니면 해당 지갑의 MonthlyTotals 를 totals 로 바꾼다 (호출 측 트랜잭션 안에서)
+    bool replaceMonthlyTotals(DatabaseHelper& helper, int walletId, const MonthlyTotalsAccumulator& totals);
+
+}
+
+#endif //POCKETMONEYAPP_MONTHLYTOTALS_H
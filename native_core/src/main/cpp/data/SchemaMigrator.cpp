@@ -0,0 +1,394 @@
+//
+// Created by ss on 2025-08-11.
+//
+
+#include "SchemaMigrator.h"
+#include "MonthlyTotals.h"
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include "../platform/Log.h"
+
+#define LOG_TAG_DAL "NativeCoreDAL"
+#define LOGD_DAL(...) PLATFORM_LOGD(LOG_TAG_DAL, __VA_ARGS__)
+#define LOGE_DAL(...) PLATFORM_LOGE(LOG_TAG_DAL, __VA_ARGS__)
+
+namespace data {
+
+    namespace {
+
+        enum class ChunkResult { MORE, DONE, FAILED };
+
+        struct SchemaStep {
+            int version;
+            const char* description;
+            bool (*apply)(DatabaseHelper& helper);
+        };
+
+        struct Backfill {
+            const char* name;
+            // cursor: SchemaBackfills.Cursor 에 남는 진행 위치. MORE 를 반환하면 같은 트랜잭션에서 저장된다
+            ChunkResult (*runChunk)(DatabaseHelper& helper, int chunkRows, int64_t& cursor);
+            bool changesTransactions; // 커밋 후 DatabaseHelper::noteBackfillChange 로 읽기 캐시를 비우게 한다
+        };
+
+        const char* const EPOCH_DATES_BACKFILL = "transactions_epoch_dates";
+        const char* const MONTHLY_TOTALS_BACKFILL = "monthly_totals";
+        const char* const SEARCH_INDEX_BACKFILL = DatabaseHelper::SEARCH_INDEX_BACKFILL; // 트리거 조건이 이 이름을 본다
+
+        bool exec(DatabaseHelper& helper, const char* sql) {
+            char *errMsg = nullptr;
+            if (sqlite3_exec(helper.getDb(), sql, 0, 0, &errMsg) != SQLITE_OK) {
+                LOGE_DAL("[SQL Error] migration: %s", errMsg);
+                sqlite3_free(errMsg);
+                return false;
+            }
+            return true;
+        }
+
+        // 한 번 쓰고 버리는 마이그레이션 SQL 은 캐시하지 않는다 (대상 테이블이 곧 삭제된다)
+        bool execWithId(DatabaseHelper& helper, const char* sql, sqlite3_int64 id) {
+            sqlite3_stmt* stmt = nullptr;
+            if (sqlite3_prepare_v2(helper.getDb(), sql, -1, &stmt, nullptr) != SQLITE_OK) {
+                LOGE_DAL("[SQL Error] migration prepare: %s", sqlite3_errmsg(helper.getDb()));
+                return false;
+            }
+            sqlite3_bind_int64(stmt, 1, id);
+            int rc = sqlite3_step(stmt);
+            sqlite3_finalize(stmt);
+            if (rc != SQLITE_DONE) {
+                LOGE_DAL("[SQL Error] migration step: %s", sqlite3_errmsg(helper.getDb()));
+                return false;
+            }
+            return true;
+        }
+
+        bool registerBackfill(DatabaseHelper& helper, const char* name) {
+            sqlite3_stmt* stmt = helper.prepareCached("INSERT OR IGNORE INTO SchemaBackfills (Name) VALUES (?);");
+            if (!stmt) return false;
+            sqlite3_bind_text(stmt, 1, name, -1, SQLITE_STATIC);
+            bool ok = sqlite3_step(stmt) == SQLITE_DONE;
+            helper.releaseStatement(stmt);
+            return ok;
+        }
+
+        bool unregisterBackfill(DatabaseHelper& helper, const char* name) {
+            sqlite3_stmt* stmt = helper.prepareCached("DELETE FROM SchemaBackfills WHERE Name = ?;");
+            if (!stmt) return false;
+            sqlite3_bind_text(stmt, 1, name, -1, SQLITE_STATIC);
+            bool ok = sqlite3_step(stmt) == SQLITE_DONE;
+            helper.releaseStatement(stmt);
+            return ok;
+        }
+
+        bool saveBackfillCursor(DatabaseHelper& helper, const char* name, int64_t cursor) {
+            sqlite3_stmt* stmt = helper.prepareCached("UPDATE SchemaBackfills SET Cursor = ? WHERE Name = ?;");
+            if (!stmt) return false;
+            sqlite3_bind_int64(stmt, 1, cursor);
+            sqlite3_bind_text(stmt, 2, name, -1, SQLITE_STATIC);
+            bool ok = sqlite3_step(stmt) == SQLITE_DONE;
+            helper.releaseStatement(stmt);
+            return ok;
+        }
+
+        // 버전 1: 거래 목록 커버링 인덱스
+        bool addListIndex(DatabaseHelper& helper) {
+            return helper.createListIndex();
+        }
+
+        // 버전 2: TransactionDate TEXT -> INTEGER epoch 초.
+        // SQLite 는 컬럼 타입을 바꿀 수 없으므로 기존 테이블을 Transactions_legacy 로 옮겨 두고 새 테이블을 바로 쓴다.
+        // 옛 행은 transactions_epoch_dates 백필이 최근 거래부터 옮긴다.
+        bool startEpochDateRebuild(DatabaseHelper& helper) {
+            bool textDates = false;
+            sqlite3_stmt* stmt = nullptr;
+            if (sqlite3_prepare_v2(helper.getDb(), "SELECT type FROM pragma_table_info('Transactions') WHERE name = 'TransactionDate';",
+                                   -1, &stmt, nullptr) != SQLITE_OK) {
+                LOGE_DAL("[SQL Error] table_info: %s", sqlite3_errmsg(helper.getDb()));
+                return false;
+            }
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                const char* type = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                textDates = type && sqlite3_stricmp(type, "INTEGER") != 0;
+            }
+            sqlite3_finalize(stmt);
+            if (!textDates) return true; // 새로 만든 DB 는 처음부터 INTEGER
+
+            // 인덱스 이름을 새 테이블에서 다시 쓰기 위해 먼저 지운다.
+            // AUTOINCREMENT 시퀀스를 이어받아 새 거래의 ID 가 나중에 옮겨 올 옛 ID 와 겹치지 않게 한다.
+            return exec(helper, "DROP INDEX IF EXISTS idx_transactions_wallet_date;"
+                                "ALTER TABLE Transactions RENAME TO Transactions_legacy;") &&
+                   helper.createTransactionsTable() &&
+                   exec(helper, "INSERT INTO sqlite_sequence (name, seq) "
+                                "SELECT 'Transactions', seq FROM sqlite_sequence WHERE name = 'Transactions_legacy';") &&
+                   helper.createListIndex() &&
+                   registerBackfill(helper, EPOCH_DATES_BACKFILL);
+        }
+
+        // Transactions_legacy 의 [fromId, toId] 중 strftime 으로 해석할 수 없는 날짜는 0 (1970-01-01) 으로 옮겨지므로,
+        // 옮기기 전에 원문을 TransactionDateRepairs 에 남기고 그 수를 로그로 알린다. 테이블은 그런 행이 있을 때만 만든다
+        bool keepUnparsableDates(DatabaseHelper& helper, sqlite3_int64 fromId, sqlite3_int64 toId) {
+            sqlite3_stmt* stmt = nullptr;
+            if (sqlite3_prepare_v2(helper.getDb(), "SELECT COUNT(*) FROM Transactions_legacy WHERE ID BETWEEN ? AND ? "
+                                                   "AND strftime('%s', TransactionDate) IS NULL;", -1, &stmt, nullptr) != SQLITE_OK) {
+                LOGE_DAL("[SQL Error] migration prepare: %s", sqlite3_errmsg(helper.getDb()));
+                return false;
+            }
+            sqlite3_bind_int64(stmt, 1, fromId);
+            sqlite3_bind_int64(stmt, 2, toId);
+            sqlite3_int64 unparsable = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int64(stmt, 0) : -1;
+            sqlite3_finalize(stmt);
+            if (unparsable < 0) {
+                LOGE_DAL("[SQL Error] migration step: %s", sqlite3_errmsg(helper.getDb()));
+                return false;
+            }
+            if (unparsable == 0) return true;
+
+            if (!exec(helper, "CREATE TABLE IF NOT EXISTS TransactionDateRepairs ("
+                              "ID INTEGER PRIMARY KEY," // Transactions.ID
+                              "TransactionDate TEXT" // 해석하지 못한 원래 값
+                              ");") ||
+                sqlite3_prepare_v2(helper.getDb(), "INSERT OR REPLACE INTO TransactionDateRepairs (ID, TransactionDate) "
+                                                   "SELECT ID, TransactionDate FROM Transactions_legacy WHERE ID BETWEEN ? AND ? "
+                                                   "AND strftime('%s', TransactionDate) IS NULL;", -1, &stmt, nullptr) != SQLITE_OK) {
+                LOGE_DAL("[SQL Error] migration prepare: %s", sqlite3_errmsg(helper.getDb()));
+                return false;
+            }
+            sqlite3_bind_int64(stmt, 1, fromId);
+            sqlite3_bind_int64(stmt, 2, toId);
+            int rc = sqlite3_step(stmt);
+            sqlite3_finalize(stmt);
+            if (rc != SQLITE_DONE) {
+                LOGE_DAL("[SQL Error] migration step: %s", sqlite3_errmsg(helper.getDb()));
+                return false;
+            }
+            LOGE_DAL("[Warning] %lld legacy transactions have unparsable dates; stored as 0, originals kept in TransactionDateRepairs.",
+                     static_cast<long long>(unparsable));
+            return true;
+        }
+
+        // 가장 큰 ID 부터 chunkRows 행을 옮기고 옛 테이블에서 지운다. 남은 행 자체가 진행 상황이다.
+        // strftime('%s') 도 벽시계 시각을 UTC 로 읽어 domain::parseDateTime 과 같은 값이 된다 (해석 불가 시 0, 원문은 따로 남긴다).
+        ChunkResult copyLegacyTransactions(DatabaseHelper& helper, int chunkRows, int64_t& /* cursor */) {
+            if (!helper.tableExists("Transactions_legacy")) return ChunkResult::DONE;
+
+            // 이번 묶음의 하한 ID. 남은 행이 chunkRows 이하이면 전부 옮기고 테이블을 지운다
+            sqlite3_int64 lowestId = INT64_MIN;
+            bool last = true;
+            sqlite3_stmt* stmt = nullptr;
+            if (sqlite3_prepare_v2(helper.getDb(), "SELECT ID FROM Transactions_legacy ORDER BY ID DESC LIMIT 1 OFFSET ?;",
+                                   -1, &stmt, nullptr) != SQLITE_OK) {
+                LOGE_DAL("[SQL Error] migration prepare: %s", sqlite3_errmsg(helper.getDb()));
+                return ChunkResult::FAILED;
+            }
+            sqlite3_bind_int(stmt, 1, chunkRows - 1);
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                lowestId = sqlite3_column_int64(stmt, 0);
+                last = false;
+            }
+            sqlite3_finalize(stmt);
+
+            bool ok = keepUnparsableDates(helper, lowestId, INT64_MAX) &&
+                      execWithId(helper,
+                                 "INSERT INTO Transactions (ID, wallet_id, Description, Amount, Type, TransactionDate) "
+                                 "SELECT ID, wallet_id, Description, Amount, Type, COALESCE(CAST(strftime('%s', TransactionDate) AS INTEGER), 0) "
+                                 "FROM Transactions_legacy WHERE ID >= ?;", lowestId) &&
+                      execWithId(helper, "DELETE FROM Transactions_legacy WHERE ID >= ?;", lowestId);
+            if (!ok) return ChunkResult::FAILED;
+            if (!last) return ChunkResult::MORE;
+            return exec(helper, "DROP TABLE Transactions_legacy;") ? ChunkResult::DONE : ChunkResult::FAILED;
+        }
+
+        // 버전 3: 지갑별 월 합계. 백필에 진행 위치가 필요해 SchemaBackfills 에 Cursor 를 더한다.
+        // 집계 백필은 등록 순서상 epoch 백필 뒤에 돌아 옛 거래까지 모두 옮겨진 뒤에 계산된다.
+        bool addMonthlyTotals(DatabaseHelper& helper) {
+            return exec(helper, "ALTER TABLE SchemaBackfills ADD COLUMN Cursor INTEGER NOT NULL DEFAULT 0;") &&
+                   helper.createMonthlyTotalsTable() &&
+                   registerBackfill(helper, MONTHLY_TOTALS_BACKFILL);
+        }
+
+        // cursor 이후의 지갑을 ID 순으로 하나씩 다시 계산한다. 지갑 단위로 지우고 다시 넣으므로
+        // 아직 계산되지 않은 지갑에 그 사이 반영된 증감분도 덮어써져 이중 계산되지 않는다.
+        // 한 지갑은 나누지 않으므로 묶음은 chunkRows 를 넘을 수 있다.
+        ChunkResult rebuildMonthlyTotals(DatabaseHelper& helper, int chunkRows, int64_t& cursor) {
+            int rows = 0;
+            while (rows < chunkRows) {
+                sqlite3_stmt* stmt = helper.prepareCached("SELECT ID FROM Wallets WHERE ID > ? ORDER BY ID LIMIT 1;");
+                if (!stmt) return ChunkResult::FAILED;
+                sqlite3_bind_int64(stmt, 1, cursor);
+                int walletId = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int(stmt, 0) : 0;
+                helper.releaseStatement(stmt);
+                if (walletId == 0) return ChunkResult::DONE;
+
+                MonthlyTotalsAccumulator totals;
+                if (!accumulateWalletMonthlyTotals(helper, walletId, totals, rows) ||
+                    !replaceMonthlyTotals(helper, walletId, totals)) {
+                    return ChunkResult::FAILED;
+                }
+                cursor = walletId;
+            }
+            return ChunkResult::MORE;
+        }
+
+        // 버전 4: Description 전문 검색. 트리거는 바로 걸고, 기존 행은 가장 큰 ID 다음부터 거꾸로 색인하는
+        // transactions_search 백필에 맡긴다. Cursor 아래의 행은 아직 색인되지 않은 것으로 본다.
+        bool addSearchIndex(DatabaseHelper& helper) {
+            int64_t nextId = 0;
+            sqlite3_stmt* stmt = helper.prepareCached("SELECT COALESCE(MAX(ID), 0) + 1 FROM Transactions;");
+            if (!stmt) return false;
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                nextId = sqlite3_column_int64(stmt, 0);
+            }
+            helper.releaseStatement(stmt);
+            if (!helper.createSearchIndex()) return false;
+            if (nextId <= 1) return true; // 색인할 행이 없다 (옛 테이블에서 옮겨 올 행은 트리거가 색인한다)
+            return registerBackfill(helper, SEARCH_INDEX_BACKFILL) &&
+                   saveBackfillCursor(helper, SEARCH_INDEX_BACKFILL, nextId);
+        }
+
+        // cursor 바로 아래부터 chunkRows 행을 색인하고 cursor 를 그 가장 작은 ID 로 내린다.
+        // 같은 트랜잭션에서 cursor 가 저장되므로 트리거와 백필이 같은 행을 두 번 넣지 않는다.
+        ChunkResult indexTransactionDescriptions(DatabaseHelper& helper, int chunkRows, int64_t& cursor) {
+            sqlite3_int64 lowestId = INT64_MIN;
+            bool last = true;
+            sqlite3_stmt* stmt = helper.prepareCached("SELECT ID FROM Transactions WHERE ID < ? ORDER BY ID DESC LIMIT 1 OFFSET ?;");
+            if (!stmt) return ChunkResult::FAILED;
+            sqlite3_bind_int64(stmt, 1, cursor);
+            sqlite3_bind_int(stmt, 2, chunkRows - 1);
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                lowestId = sqlite3_column_int64(stmt, 0);
+                last = false;
+            }
+            helper.releaseStatement(stmt);
+
+            stmt = helper.prepareCached("INSERT INTO TransactionsFts (rowid, Description, wallet_id) "
+                                        "SELECT ID, Description, wallet_id FROM Transactions WHERE ID >= ? AND ID < ?;");
+            if (!stmt) return ChunkResult::FAILED;
+            sqlite3_bind_int64(stmt, 1, lowestId);
+            sqlite3_bind_int64(stmt, 2, cursor);
+            bool ok = sqlite3_step(stmt) == SQLITE_DONE;
+            helper.releaseStatement(stmt);
+            if (!ok) {
+                LOGE_DAL("[SQL Error] search backfill: %s", sqlite3_errmsg(helper.getDb()));
+                return ChunkResult::FAILED;
+            }
+            if (last) return ChunkResult::DONE;
+            cursor = lowestId;
+            return ChunkResult::MORE;
+        }
+
+        constexpr SchemaStep SCHEMA_STEPS[] = {
+                {1, "transactions list index", addListIndex},
+                {2, "epoch transaction dates", startEpochDateRebuild},
+                {3, "monthly totals", addMonthlyTotals},
+                {4, "transaction search index", addSearchIndex},
+        };
+        static_assert(SCHEMA_STEPS[std::size(SCHEMA_STEPS) - 1].version == DatabaseHelper::SCHEMA_VERSION,
+                      "SCHEMA_VERSION must match the last schema step");
+
+        constexpr Backfill BACKFILLS[] = {
+                {EPOCH_DATES_BACKFILL, copyLegacyTransactions, true},
+                {MONTHLY_TOTALS_BACKFILL, rebuildMonthlyTotals, false},
+                {SEARCH_INDEX_BACKFILL, indexTransactionDescriptions, false},
+        };
+
+        const Backfill* findBackfill(const std::string& name) {
+            for (const Backfill& backfill : BACKFILLS) {
+                if (name == backfill.name) return &backfill;
+            }
+            return nullptr;
+        }
+
+    }
+
+    SchemaMigrator::SchemaMigrator(DatabaseHelper& helper) : dbHelper(helper) {}
+
+    bool SchemaMigrator::migrateSchema() {
+        if (!dbHelper.getDb()) {
+            LOGE_DAL("[Error] DB not open for migrateSchema.");
+            return false;
+        }
+        if (!exec(dbHelper, "CREATE TABLE IF NOT EXISTS SchemaBackfills (Name TEXT PRIMARY KEY);")) {
+            return false;
+        }
+
+        int version = dbHelper.getUserVersion();
+        if (version > DatabaseHelper::SCHEMA_VERSION) {
+            // 더 새로운 앱이 만든 DB. 아는 범위의 스키마만 사용한다
+            LOGE_DAL("[Error] DB schema version %d is newer than %d.", version, DatabaseHelper::SCHEMA_VERSION);
+            return true;
+        }
+
+        for (const SchemaStep& step : SCHEMA_STEPS) {
+            if (step.version <= version) continue;
+            ScopedTransaction tx(dbHelper);
+            if (!tx.isActive() || !step.apply(dbHelper) || !dbHelper.setUserVersion(step.version) || !tx.commit()) {
+                LOGE_DAL("[Error] Schema migration to version %d (%s) failed.", step.version, step.description);
+                return false;
+            }
+            LOGD_DAL("[Info] Schema upgraded to version %d (%s).", step.version, step.description);
+        }
+        return true;
+    }
+
+    MigrationStatus SchemaMigrator::runBackfills(std::chrono::milliseconds budget, int chunkRows) {
+        if (!dbHelper.getDb()) {
+            LOGE_DAL("[Error] DB not open for runBackfills.");
+            return MigrationStatus::FAILED;
+        }
+        if (chunkRows <= 0) chunkRows = DEFAULT_CHUNK_ROWS;
+
+        auto deadline = std::chrono::steady_clock::now() + budget;
+        while (true) {
+            std::string name;
+            int64_t cursor = 0;
+            sqlite3_stmt* stmt = dbHelper.prepareCached("SELECT Name, Cursor FROM SchemaBackfills ORDER BY rowid LIMIT 1;");
+            if (!stmt) return MigrationStatus::FAILED;
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                cursor = sqlite3_column_int64(stmt, 1);
+            }
+            dbHelper.releaseStatement(stmt);
+            if (name.empty()) return MigrationStatus::COMPLETE;
+
+            const Backfill* backfill = findBackfill(name);
+            if (!backfill) {
+                LOGE_DAL("[Error] Unknown backfill %s.", name.c_str());
+                return MigrationStatus::FAILED;
+            }
+
+            ScopedTransaction tx(dbHelper);
+            if (!tx.isActive()) return MigrationStatus::FAILED;
+            ChunkResult result = backfill->runChunk(dbHelper, chunkRows, cursor);
+            if (result == ChunkResult::FAILED ||
+                (result == ChunkResult::MORE && !saveBackfillCursor(dbHelper, backfill->name, cursor)) ||
+                (result == ChunkResult::DONE && !unregisterBackfill(dbHelper, backfill->name)) || !tx.commit()) {
+                LOGE_DAL("[Error] Backfill %s failed.", backfill->name);
+                return MigrationStatus::FAILED;
+            }
+            if (backfill->changesTransactions) {
+                dbHelper.noteBackfillChange();
+            }
+            if (result == ChunkResult::DONE) {
+                LOGD_DAL("[Info] Backfill %s finished.", backfill->name);
+            }
+
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return hasPendingBackfills() ? MigrationStatus::PENDING : MigrationStatus::COMPLETE;
+            }
+        }
+    }
+
+    bool SchemaMigrator::keepUnparsableLegacyDates(int64_t fromId, int64_t toId) {
+        return keepUnparsableDates(dbHelper, fromId, toId);
+    }
+
+    bool SchemaMigrator::hasPendingBackfills() {
+        sqlite3_stmt* stmt = dbHelper.prepareCached("SELECT 1 FROM SchemaBackfills LIMIT 1;");
+        if (!stmt) return false;
+        bool pending = sqlite3_step(stmt) == SQLITE_ROW;
+        dbHelper.releaseStatement(stmt);
+        return pending;
+    }
+
+}
@@ -0,0 +1,49 @@
+//
+// Created by ss on 2025-08-11.
+//
+
+#ifndef POCKETMONEYAPP_SCHEMAMIGRATOR_H
+#define POCKETMONEYAPP_SCHEMAMIGRATOR_H
+
+#include "DatabaseHelper.h"
+#include <chrono>
+
+namespace data {
+
+    enum class MigrationStatus {
+        COMPLETE, // 스키마와 백필 모두 최신
+        PENDING,  // 시간 예산을 다 써서 백필이 남았다. 다시 호출하면 이어서 진행한다
+        FAILED
+    };
+
+    // PRAGMA user_version 기반 스키마 마이그레이션.
+    //  - 스키마 단계: 버전 순서대로 각각 하나의 트랜잭션에서 실행하고, 같은 트랜잭션에서 user_version 을 올린다.
+    //    시작할 때마다 끝까지 실행하므로 DDL 처럼 데이터 양과 무관하게 빨리 끝나는 작업만 둔다.
+    //  - 백필: 큰 테이블 재작성처럼 오래 걸리는 작업. 스키마 단계가 SchemaBackfills 테이블에 이름을 등록하고,
+    //    runBackfills 가 등록 순서대로 chunkRows 행씩 각각의 트랜잭션으로 진행한다. 진행 상황(남은 데이터 또는
+    //    SchemaBackfills.Cursor)은 DB 에 남으므로 중간에 앱이 종료되어도 다음 실행에서 이어진다.
+    //    묶음 사이의 DB 는 현재 코드가 그대로 읽고 쓸 수 있는 상태여야 한다.
+    // 쓰기 커넥션에서 쓰기 잠금을 잡은 채로 호출한다.
+    class SchemaMigrator {
+    public:
+        static constexpr int DEFAULT_CHUNK_ROWS = 2000;
+
+        explicit SchemaMigrator(DatabaseHelper& helper);
+
+        bool migrateSchema();
+
+        // budget 이 지나면 현재 묶음을 커밋하고 멈춘다. 호출마다 최소 한 묶음은 진행한다
+        MigrationStatus runBackfills(std::chrono::milliseconds budget, int chunkRows = DEFAULT_CHUNK_ROWS);
+        bool hasPendingBackfills();
+
+        // 버전 2 백필 밖에서 옛 행을 옮기기 전에 부른다. [fromId, toId] 중 해석할 수 없는 TEXT 날짜의 원문을
+        // TransactionDateRepairs 에 남긴다 (옮겨진 행의 날짜는 0). 호출 측 트랜잭션 안에서 실행한다
+        bool keepUnparsableLegacyDates(int64_t fromId, int64_t toId);
+
+    private:
+        DatabaseHelper& dbHelper;
+    };
+
+}
+
+#endif //POCKETMONEYAPP_SCHEMAMIGRATOR_H
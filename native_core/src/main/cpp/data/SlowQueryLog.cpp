@@ -0,0 +1,65 @@
+//
+// Created by ss on 2025-08-10.
+//
+
+#include "SlowQueryLog.h"
+#include <algorithm>
+
+namespace data {
+
+    namespace {
+        bool fasterThan(const SlowQueryEntry& a, const SlowQueryEntry& b) {
+            return a.durationNanos > b.durationNanos; // std::*_heap 에서 최소 힙으로 쓰기 위한 비교
+        }
+    }
+
+    SlowQueryLog::SlowQueryLog(size_t capacity, int64_t thresholdNanos)
+            : capacity(capacity > 0 ? capacity : 1), thresholdNanos(thresholdNanos), admissionFloor(thresholdNanos) {
+        entries.reserve(this->capacity);
+    }
+
+    bool SlowQueryLog::wouldKeep(int64_t durationNanos) const {
+        return durationNanos >= admissionFloor.load(std::memory_order_relaxed);
+    }
+
+    void SlowQueryLog::offer(SlowQueryEntry entry) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (entry.durationNanos < thresholdNanos) return;
+        if (entries.size() < capacity) {
+            entries.push_back(std::move(entry));
+            std::push_heap(entries.begin(), entries.end(), fasterThan);
+        } else if (entry.durationNanos > entries.front().durationNanos) {
+            std::pop_heap(entries.begin(), entries.end(), fasterThan);
+            entries.back() = std::move(entry);
+            std::push_heap(entries.begin(), entries.end(), fasterThan);
+        } else {
+            return;
+        }
+        if (entries.size() == capacity) {
+            admissionFloor.store(std::max(thresholdNanos, entries.front().durationNanos), std::memory_order_relaxed);
+        }
+    }
+
+    std::vector<SlowQueryEntry> SlowQueryLog::snapshot(bool reset) {
+        std::vector<SlowQueryEntry> result;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            result = entries;
+            if (reset) {
+                entries.clear();
+                admissionFloor.store(thresholdNanos, std::memory_order_relaxed);
+            }
+        }
+        std::sort(result.begin(), result.end(), fasterThan);
+        return result;
+    }
+
+    size_t SlowQueryLog::getCapacity() const {
+        return capacity;
+    }
+
+    int64_t SlowQueryLog::getThresholdNanos() const {
+        return thresholdNanos;
+    }
+
+}
@@ -0,0 +1,49 @@
+//
+// Created by ss on 2025-08-10.
+//
+
+#ifndef POCKETMONEYAPP_SLOWQUERYLOG_H
+#define POCKETMONEYAPP_SLOWQUERYLOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace data {
+
+    struct SlowQueryEntry {
+        std::string sql;          // 바인딩 값이 채워진 SQL (sqlite3_expanded_sql)
+        int64_t durationNanos;
+        int64_t rows;             // 실행 동안 반환된 행 수
+        int vmSteps;              // SQLITE_STMTSTATUS_VM_STEP
+        int fullScanSteps;        // SQLITE_STMTSTATUS_FULLSCAN_STEP
+        int sorts;                // SQLITE_STMTSTATUS_SORT
+    };
+
+    // 가장 느린 statement capacity 개만 남기는 고정 크기 버퍼. 여러 커넥션의 trace 콜백이 함께 쓴다.
+    // 꽉 찬 뒤에는 현재 최솟값보다 빠른 실행을 잠금 없이 걸러낸다.
+    class SlowQueryLog {
+    public:
+        SlowQueryLog(size_t capacity, int64_t thresholdNanos);
+
+        bool wouldKeep(int64_t durationNanos) const;
+        void offer(SlowQueryEntry entry);
+        std::vector<SlowQueryEntry> snapshot(bool reset); // 느린 순
+
+        size_t getCapacity() const;
+        int64_t getThresholdNanos() const;
+
+    private:
+        size_t capacity;
+        int64_t thresholdNanos;
+        std::atomic<int64_t> admissionFloor; // 이보다 빠르면 버린다 (threshold 또는 꽉 찼을 때의 최솟값)
+        std::mutex mutex;
+        std::vector<SlowQueryEntry> entries; // durationNanos 기준 최소 힙
+    };
+
+}
+
+#endif //POCKETMONEYAPP_SLOWQUERYLOG_H
@@ -0,0 +1,317 @@
+//
+// Created by ss on 2025-08-12.
+//
+
+#include "TransactionExporter.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../domain/DateTime.h"
+#include "../domain/Transaction.h"
+#include "../platform/Log.h"
+
+#define LOG_TAG_DAL "NativeCoreDAL"
+#define LOGD_DAL(...) PLATFORM_LOGD(LOG_TAG_DAL, __VA_ARGS__)
+#define LOGE_DAL(...) PLATFORM_LOGE(LOG_TAG_DAL, __VA_ARGS__)
+
+namespace data {
+
+    namespace {
+
+        // 지갑 목록 커버링 인덱스를 거꾸로 읽으므로 정렬도 테이블 조회도 없다
+        const char* const EXPORT_WALLET_SQL =
+                "SELECT id, wallet_id, description, amount, type, TransactionDate FROM Transactions WHERE wallet_id = ? "
+                "ORDER BY TransactionDate, id;";
+
+        const char* const EXPORT_ALL_SQL =
+                "SELECT id, wallet_id, description, amount, type, TransactionDate FROM Transactions ORDER BY id;";
+
+        // 스키마 버전 2 백필 중에는 아직 옮겨지지 않은 거래가 Transactions_legacy 에 TEXT 날짜로 남아 있다
+        const char* const EXPORT_LEGACY_SQL =
+                "SELECT ID, wallet_id, Description, Amount, Type, COALESCE(CAST(strftime('%s', TransactionDate) AS INTEGER), 0) "
+                "FROM Transactions_legacy WHERE ?1 = 0 OR wallet_id = ?1 ORDER BY ID;";
+
+        constexpr size_t MIN_BUFFER_BYTES = 4096;
+        constexpr size_t MAX_PIECE_BYTES = 32; // 숫자/날짜/이스케이프 한 조각의 최대 길이
+
+        // 고정 크기 버퍼에 서식화해 쓰고 가득 차면 fd 로 내보낸다. 쓰기 실패나 취소 후에는 아무것도 하지 않는다
+        class FdWriter {
+        public:
+            FdWriter(int fd, size_t capacity, const ExportProgressCallback& progress, ExportProgress& counters)
+                    : fd(fd), buffer(capacity), used(0), progress(progress), counters(counters) {}
+
+            bool ok() const { return !failed && !cancelled; }
+            bool wasCancelled() const { return cancelled; }
+
+            // 조각 하나를 쓸 자리를 확보한다
+            char* reserve(size_t n) {
+                if (used + n > buffer.size()) flush();
+                return buffer.data() + used;
+            }
+
+            void put(char c) {
+                *reserve(1) = c;
+                ++used;
+            }
+
+            void put(const char* p, size_t n) {
+                while (n > 0) {
+                    if (used == buffer.size()) flush();
+                    if (!ok()) return;
+                    size_t chunk = std::min(n, buffer.size() - used);
+                    std::memcpy(buffer.data() + used, p, chunk);
+                    used += chunk;
+                    p += chunk;
+                    n -= chunk;
+                }
+            }
+
+            template<size_t N>
+            void put(const char (&literal)[N]) {
+                put(literal, N - 1);
+            }
+
+            void putInteger(long long value) {
+                char digits[24];
+                char* end = digits + sizeof(digits);
+                char* p = end;
+                unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value)
+                                                         : static_cast<unsigned long long>(value);
+                do {
+                    *--p = static_cast<char>('0' + magnitude % 10);
+                    magnitude /= 10;
+                } while (magnitude > 0);
+                if (value < 0) *--p = '-';
+                put(p, static_cast<size_t>(end - p));
+            }
+
+            void putDateTime(int64_t epochSeconds) {
+                char* out = reserve(domain::DATE_TIME_LENGTH + 1); // formatDateTime 이 NUL 까지 쓴다
+                domain::formatDateTime(epochSeconds, out);
+                used += domain::DATE_TIME_LENGTH;
+            }
+
+            // RFC 4180: 쉼표, 따옴표, 개행이 있으면 따옴표로 감싸고 안의 따옴표는 두 번 쓴다.
+            // 앞뒤 공백도 스프레드시트가 지우지 않도록 감싼다 (CsvTransactionImporter 는 감싸도 공백을 잘라낸다)
+            void putCsvField(const char* p, size_t n) {
+                bool quote = n > 0 && (p[0] == ' ' || p[0] == '\t' || p[n - 1] == ' ' || p[n - 1] == '\t');
+                for (size_t i = 0; i < n && !quote; ++i) {
+                    quote = p[i] == ',' || p[i] == '"' || p[i] == '\n' || p[i] == '\r';
+                }
+                if (!quote) {
+                    put(p, n);
+                    return;
+                }
+                put('"');
+                size_t start = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    if (p[i] == '"') {
+                        put(p + start, i + 1 - start);
+                        put('"');
+                        start = i + 1;
+                    }
+                }
+                put(p + start, n - start);
+                put('"');
+            }
+
+            // 따옴표, 역슬래시, 제어 문자만 이스케이프하고 UTF-8 은 그대로 쓴다
+            void putJsonString(const char* p, size_t n) {
+                static const char hex[] = "0123456789abcdef";
+                put('"');
+                size_t start = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    unsigned char c = static_cast<unsigned char>(p[i]);
+                    if (c >= 0x20 && c != '"' && c != '\\') continue;
+                    put(p + start, i - start);
+                    start = i + 1;
+                    char* out = reserve(MAX_PIECE_BYTES);
+                    out[0] = '\\';
+                    size_t length = 2;
+                    switch (c) {
+                        case '"': out[1] = '"'; break;
+                        case '\\': out[1] = '\\'; break;
+                        case '\n': out[1] = 'n'; break;
+                        case '\r': out[1] = 'r'; break;
+                        case '\t': out[1] = 't'; break;
+                        case '\b': out[1] = 'b'; break;
+                        case '\f': out[1] = 'f'; break;
+                        default:
+                            out[1] = 'u';
+                            out[2] = '0';
+                            out[3] = '0';
+                            out[4] = hex[c >> 4];
+                            out[5] = hex[c & 0xF];
+                            length = 6;
+                    }
+                    used += length;
+                }
+                put(p + start, n - start);
+                put('"');
+            }
+
+            void flush() {
+                size_t offset = 0;
+                while (ok() && offset < used) {
+                    ssize_t written = write(fd, buffer.data() + offset, used - offset);
+                    if (written < 0) {
+                        if (errno == EINTR) continue;
+                        LOGE_DAL("[Error] Export write failed: %s", std::strerror(errno));
+                        failed = true;
+                        break;
+                    }
+                    offset += static_cast<size_t>(written);
+                }
+                counters.bytesWritten += static_cast<int64_t>(offset);
+                used = 0; // 실패/취소 뒤의 쓰기는 버퍼 안에서 버려진다
+                if (ok() && progress && !progress(counters)) {
+                    cancelled = true;
+                }
+            }
+
+        private:
+            int fd;
+            std::vector<char> buffer;
+            size_t used;
+            bool failed = false;
+            bool cancelled = false;
+            const ExportProgressCallback& progress;
+            ExportProgress& counters;
+        };
+
+        const char* typeName(int type) {
+            return type == static_cast<int>(domain::TransactionType::INCOME) ? "income" : "expense";
+        }
+
+        void writeRow(FdWriter& out, ExportFormat format, sqlite3_stmt* stmt) {
+            const char* description = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+            size_t descriptionBytes = description ? static_cast<size_t>(sqlite3_column_bytes(stmt, 2)) : 0;
+            if (!description) description = ""; // Description 은 NULL 허용
+            const char* type = typeName(sqlite3_column_int(stmt, 4));
+
+            if (format == ExportFormat::CSV) {
+                out.putInteger(sqlite3_column_int64(stmt, 0));
+                out.put(',');
+                out.putInteger(sqlite3_column_int64(stmt, 1));
+                out.put(',');
+                out.putDateTime(sqlite3_column_int64(stmt, 5));
+                out.put(',');
+                out.putCsvField(description, descriptionBytes);
+                out.put(',');
+                out.putInteger(sqlite3_column_int64(stmt, 3));
+                out.put(',');
+                out.put(type, std::strlen(type));
+                out.put('\n');
+            } else {
+                out.put("{\"id\":");
+                out.putInteger(sqlite3_column_int64(stmt, 0));
+                out.put(",\"wallet_id\":");
+                out.putInteger(sqlite3_column_int64(stmt, 1));
+                out.put(",\"date\":\"");
+                out.putDateTime(sqlite3_column_int64(stmt, 5));
+                out.put("\",\"description\":");
+                out.putJsonString(description, descriptionBytes);
+                out.put(",\"amount\":");
+                out.putInteger(sqlite3_column_int64(stmt, 3));
+                out.put(",\"type\":\"");
+                out.put(type, std::strlen(type));
+                out.put("\"}\n");
+            }
+        }
+
+        // stmt 의 모든 행을 쓴다. SQL 오류면 false
+        bool writeRows(DatabaseHelper& helper, sqlite3_stmt* stmt, FdWriter& out, ExportFormat format, ExportProgress& counters) {
+            int rc;
+            while (out.ok() && (rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+                writeRow(out, format, stmt);
+                ++counters.rowsWritten;
+            }
+            if (out.ok() && rc != SQLITE_DONE) {
+                LOGE_DAL("[SQL Error] export step: %s", sqlite3_errmsg(helper.getDb()));
+                return false;
+            }
+            return true;
+        }
+
+    }
+
+    TransactionExporter::TransactionExporter(ConnectionManager& connections, const ExportOptions& options)
+            : connections(connections), options(options) {
+        if (this->options.bufferBytes < MIN_BUFFER_BYTES) this->options.bufferBytes = MIN_BUFFER_BYTES;
+    }
+
+    ExportResult TransactionExporter::exportToFile(const std::string& path, const ExportProgressCallback& progress) {
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            LOGE_DAL("[Error] Cannot create export file %s: %s", path.c_str(), std::strerror(errno));
+            return ExportResult();
+        }
+        ExportResult result = exportToFd(fd, progress);
+        if (close(fd) != 0 && result.success) {
+            LOGE_DAL("[Error] Closing export file %s failed: %s", path.c_str(), std::strerror(errno));
+            result.success = false;
+        }
+        return result;
+    }
+
+    ExportResult TransactionExporter::exportToFd(int fd, const ExportProgressCallback& progress) {
+        ExportResult result;
+
+        // 풀의 읽기 커넥션을 오래 붙잡지 않도록 전용 커넥션을 쓴다. WAL 이 아니면 쓰기 잠금을 잡고 쓰기 커넥션으로 읽는다
+        std::unique_ptr<DatabaseHelper> scanReader = connections.openScanReader();
+        std::unique_lock<std::recursive_mutex> writeLock;
+        if (!scanReader) writeLock = connections.lockWriter();
+        DatabaseHelper& helper = scanReader ? *scanReader : connections.writer();
+
+        // 두 문장(백필 중 legacy 포함)이 같은 스냅샷을 보도록 읽기 트랜잭션으로 묶는다
+        bool ownsTransaction = sqlite3_get_autocommit(helper.getDb()) != 0;
+        if (ownsTransaction && !helper.execute("BEGIN;")) {
+            LOGE_DAL("[SQL Error] export begin: %s", sqlite3_errmsg(helper.getDb()));
+            return result;
+        }
+
+        FdWriter out(fd, options.bufferBytes, progress, result.progress);
+        if (options.format == ExportFormat::CSV) {
+            out.put("id,wallet_id,date,description,amount,type\n");
+        }
+
+        bool ok = true;
+        sqlite3_stmt* stmt = helper.prepareCached(options.walletId > 0 ? EXPORT_WALLET_SQL : EXPORT_ALL_SQL);
+        if (!stmt) {
+            LOGE_DAL("[SQL Error] export prepare: %s", sqlite3_errmsg(helper.getDb()));
+            ok = false;
+        } else {
+            if (options.walletId > 0) sqlite3_bind_int(stmt, 1, options.walletId);
+            ok = writeRows(helper, stmt, out, options.format, result.progress);
+            helper.releaseStatement(stmt);
+        }
+
+        if (ok && out.ok() && helper.tableExists("Transactions_legacy")) {
+            stmt = helper.prepareCached(EXPORT_LEGACY_SQL);
+            if (!stmt) {
+                LOGE_DAL("[SQL Error] export legacy prepare: %s", sqlite3_errmsg(helper.getDb()));
+                ok = false;
+            } else {
+                sqlite3_bind_int(stmt, 1, options.walletId > 0 ? options.walletId : 0);
+                ok = writeRows(helper, stmt, out, options.format, result.progress);
+                helper.releaseStatement(stmt);
+            }
+        }
+
+        if (ownsTransaction) helper.execute("COMMIT;"); // 읽기만 했으므로 결과와 무관하게 스냅샷을 놓는다
+        if (ok && out.ok()) out.flush();
+
+        result.cancelled = out.wasCancelled();
+        result.success = ok && out.ok();
+        LOGD_DAL("[Info] Exported %lld transactions (%lld bytes, success %d, cancelled %d).",
+                 static_cast<long long>(result.progress.rowsWritten), static_cast<long long>(result.progress.bytesWritten),
+                 result.success, result.cancelled);
+        return result;
+    }
+
+}
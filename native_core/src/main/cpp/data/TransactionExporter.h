@@ -0,0 +1,59 @@
+//
+// Created by ss on 2025-08-12.
+//
+
+#ifndef POCKETMONEYAPP_TRANSACTIONEXPORTER_H
+#define POCKETMONEYAPP_TRANSACTIONEXPORTER_H
+
+#include "ConnectionManager.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace data {
+
+    enum class ExportFormat {
+        CSV = 0,        // 헤더 id,wallet_id,date,description,amount,type. CsvTransactionImporter 로 다시 가져올 수 있다
+        JSON_LINES = 1  // 한 줄에 거래 하나: {"id":1,"wallet_id":2,"date":"...","description":"...","amount":4500,"type":"expense"}
+    };
+
+    struct ExportOptions {
+        ExportFormat format = ExportFormat::CSV;
+        int walletId = 0;                // 0 이면 모든 지갑
+        size_t bufferBytes = 64 * 1024;  // 출력 버퍼. 가득 찰 때마다 write() 한다
+    };
+
+    struct ExportProgress {
+        int64_t rowsWritten = 0;
+        int64_t bytesWritten = 0; // fd 에 실제로 쓴 바이트
+    };
+
+    struct ExportResult {
+        bool success = false;
+        bool cancelled = false;
+        ExportProgress progress;
+    };
+
+    // 버퍼를 비울 때마다 불린다. false 를 돌려주면 내보내기를 멈춘다
+    using ExportProgressCallback = std::function<bool(const ExportProgress&)>;
+
+    // 거래를 sqlite3_stmt 커서로 한 행씩 읽어 재사용 버퍼에 직접 기록하고 fd 로 흘려보낸다.
+    // 행을 도메인 객체로 만들지 않고 금액/날짜도 할당 없이 서식화하므로 메모리는 원장 크기와 무관하다.
+    // 별도 읽기 전용 커넥션(openScanReader)의 읽기 트랜잭션 하나에서 읽으므로 결과는 한 시점의 스냅샷이다.
+    // 순서: 지갑 지정 시 (TransactionDate, ID) 오름차순 (idx_transactions_wallet_date), 전체는 ID 순 (정렬 없는 테이블 스캔).
+    class TransactionExporter {
+    public:
+        explicit TransactionExporter(ConnectionManager& connections, const ExportOptions& options = ExportOptions());
+
+        ExportResult exportToFile(const std::string& path, const ExportProgressCallback& progress = nullptr);
+        ExportResult exportToFd(int fd, const ExportProgressCallback& progress = nullptr); // fd 는 닫지 않는다
+
+    private:
+        ConnectionManager& connections;
+        ExportOptions options;
+    };
+
+}
+
+#endif //POCKETMONEYAPP_TRANSACTIONEXPORTER_H
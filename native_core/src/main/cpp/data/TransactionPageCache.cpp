@@ -0,0 +1,205 @@
+//
+// Created by ss on 2025-08-12.
+//
+
+#include "TransactionPageCache.h"
+#include <algorithm>
+#include <functional>
+#include "../platform/Log.h"
+
+#define LOG_TAG_DAL "NativeCoreDAL"
+#define LOGD_DAL(...) PLATFORM_LOGD(LOG_TAG_DAL, __VA_ARGS__)
+
+namespace data {
+
+    namespace {
+
+        // (date, id) 내림차순 목록에서 a 가 b 보다 오래된(뒤에 오는) 행인지
+        bool olderThan(int64_t dateA, int idA, int64_t dateB, int idB) {
+            return dateA != dateB ? dateA < dateB : idA < idB;
+        }
+
+        const size_t ENTRY_OVERHEAD_BYTES = 128; // 리스트/해시 노드와 Entry 자체
+
+    }
+
+    bool TransactionPageCache::Key::operator==(const Key& other) const {
+        return walletId == other.walletId && afterDate == other.afterDate && afterId == other.afterId &&
+               limit == other.limit && withRunningBalances == other.withRunningBalances;
+    }
+
+    size_t TransactionPageCache::KeyHash::operator()(const Key& key) const {
+        size_t h = std::hash<int64_t>()(key.afterDate);
+        h = h * 31 + static_cast<size_t>(key.walletId);
+        h = h * 31 + static_cast<size_t>(key.afterId);
+        h = h * 31 + static_cast<size_t>(key.limit);
+        return h * 2 + (key.withRunningBalances ? 1 : 0);
+    }
+
+    TransactionPageCache::TransactionPageCache(DatabaseHelper& writer, size_t budgetBytes)
+            : dbHelper(writer), budgetBytes(budgetBytes), backfillSeen(writer.getBackfillChanges()) {}
+
+    size_t TransactionPageCache::estimateBytes(const TransactionPage& page) {
+        size_t total = ENTRY_OVERHEAD_BYTES + sizeof(Entry) + page.transactions.capacity() * sizeof(domain::Transaction) +
+                       page.runningBalances.capacity() * sizeof(long long);
+        for (const domain::Transaction& transaction : page.transactions) {
+            // 짧은 문자열은 std::string 안에 들어가므로 따로 세지 않는다
+            if (transaction.description.capacity() >= sizeof(std::string)) {
+                total += transaction.description.capacity() + 1;
+            }
+        }
+        return total;
+    }
+
+    void TransactionPageCache::flushPendingLocked() {
+        // 백필이 Transactions 를 옮겼다: 지금까지 넣은 페이지와 그 전에 시작한 조회를 모두 버린다
+        uint64_t backfillChanges = dbHelper.getBackfillChanges();
+        if (backfillChanges != backfillSeen) {
+            backfillSeen = backfillChanges;
+            stats.invalidations += lru.size();
+            clearLocked();
+        }
+        if (pending.empty() || dbHelper.getOuterTransactionEnds() == pendingSince) return;
+        // 바깥 트랜잭션이 끝났다: 그동안 읽기 커넥션에서 옛 스냅샷으로 채운 페이지를 지운다
+        std::unordered_map<int, std::vector<Change>> changes;
+        changes.swap(pending);
+        for (const auto& wallet : changes) {
+            for (const Change& change : wallet.second) {
+                invalidateLocked(wallet.first, change.date, change.id);
+            }
+        }
+    }
+
+    void TransactionPageCache::invalidateLocked(int walletId, int64_t date, int id) {
+        changedAt[walletId] = ++version;
+        auto it = byWallet.find(walletId);
+        if (it == byWallet.end()) return;
+
+        std::vector<std::list<Entry>::iterator> stale;
+        for (auto entry : it->second) {
+            bool belowUpper = !entry->hasUpper || olderThan(date, id, entry->key.afterDate, entry->key.afterId);
+            bool aboveLower = !entry->hasLower || !olderThan(date, id, entry->lowerDate, entry->lowerId);
+            if (belowUpper && (aboveLower || entry->key.withRunningBalances)) {
+                stale.push_back(entry);
+            }
+        }
+        for (auto entry : stale) {
+            eraseLocked(entry);
+            ++stats.invalidations;
+        }
+    }
+
+    void TransactionPageCache::eraseLocked(std::list<Entry>::iterator it) {
+        auto wallet = byWallet.find(it->key.walletId);
+        if (wallet != byWallet.end()) {
+            auto& entries = wallet->second;
+            auto position = std::find(entries.begin(), entries.end(), it);
+            if (position != entries.end()) {
+                *position = entries.back();
+                entries.pop_back();
+            }
+            if (entries.empty()) byWallet.erase(wallet);
+        }
+        bytes -= it->bytes;
+        index.erase(it->key);
+        lru.erase(it);
+    }
+
+    void TransactionPageCache::evictLocked() {
+        while (bytes > budgetBytes && !lru.empty()) {
+            eraseLocked(std::prev(lru.end()));
+            ++stats.evictions;
+        }
+    }
+
+    bool TransactionPageCache::get(const Key& key, TransactionPage& page) {
+        std::lock_guard<std::mutex> lock(mutex);
+        flushPendingLocked();
+        auto it = index.find(key);
+        if (it == index.end() || pending.count(key.walletId)) {
+            ++stats.misses;
+            return false;
+        }
+        lru.splice(lru.begin(), lru, it->second);
+        page = it->second->page;
+        ++stats.hits;
+        return true;
+    }
+
+    uint64_t TransactionPageCache::beginRead() {
+        std::lock_guard<std::mutex> lock(mutex);
+        flushPendingLocked();
+        return version;
+    }
+
+    void TransactionPageCache::put(const Key& key, TransactionPage page, uint64_t readVersion) {
+        std::lock_guard<std::mutex> lock(mutex);
+        flushPendingLocked();
+        if (budgetBytes == 0 || clearedAt > readVersion || pending.count(key.walletId)) return;
+        auto changed = changedAt.find(key.walletId);
+        if (changed != changedAt.end() && changed->second > readVersion) return; // 읽는 동안 바뀌었다
+
+        size_t size = estimateBytes(page);
+        if (size > budgetBytes) return;
+        auto existing = index.find(key);
+        if (existing != index.end()) {
+            eraseLocked(existing->second);
+        }
+
+        bool hasLower = page.hasMore && key.limit > 0;
+        Entry entry{key, std::move(page), size, key.afterId > 0 && key.limit > 0, hasLower, 0, 0};
+        if (hasLower) {
+            entry.lowerDate = entry.page.nextDate;
+            entry.lowerId = entry.page.nextId;
+        }
+        lru.push_front(std::move(entry));
+        index[key] = lru.begin();
+        byWallet[key.walletId].push_back(lru.begin());
+        bytes += size;
+        evictLocked();
+    }
+
+    void TransactionPageCache::onChanged(int walletId, int64_t date, int id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        flushPendingLocked();
+        invalidateLocked(walletId, date, id);
+        if (dbHelper.inTransaction()) {
+            if (pending.empty()) pendingSince = dbHelper.getOuterTransactionEnds();
+            pending[walletId].push_back({date, id});
+        }
+    }
+
+    void TransactionPageCache::clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        clearLocked();
+    }
+
+    void TransactionPageCache::clearLocked() {
+        lru.clear();
+        index.clear();
+        byWallet.clear();
+        changedAt.clear();
+        bytes = 0;
+        clearedAt = ++version;
+    }
+
+    void TransactionPageCache::setBudget(size_t budget) {
+        std::lock_guard<std::mutex> lock(mutex);
+        budgetBytes = budget;
+        evictLocked();
+        LOGD_DAL("[Info] Page cache budget set to %zu bytes.", budgetBytes);
+    }
+
+    PageCacheStats TransactionPageCache::getStats(bool reset) {
+        std::lock_guard<std::mutex> lock(mutex);
+        PageCacheStats snapshot = stats;
+        snapshot.bytes = bytes;
+        snapshot.entries = lru.size();
+        snapshot.budgetBytes = budgetBytes;
+        if (reset) {
+            stats = PageCacheStats();
+        }
+        return snapshot;
+    }
+
+}
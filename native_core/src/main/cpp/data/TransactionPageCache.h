@@ -0,0 +1,121 @@
+//
+// Created by ss on 2025-08-12.
+//
+
+#ifndef POCKETMONEYAPP_TRANSACTIONPAGECACHE_H
+#define POCKETMONEYAPP_TRANSACTIONPAGECACHE_H
+
+#include "../domain/Transaction.h"
+#include "DatabaseHelper.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace data {
+
+    // 키셋 페이지네이션 결과. 다음 페이지는 (nextDate, nextId) 이후부터 조회한다.
+    struct TransactionPage {
+        std::vector<domain::Transaction> transactions;
+        bool hasMore = false;
+        int64_t nextDate = 0; // epoch 초
+        int nextId = 0;
+        std::vector<long long> runningBalances; // withRunningBalances 일 때 거래별로 해당 거래까지 반영된 잔액
+    };
+
+    struct PageCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;      // 예산을 넘어 밀려난 페이지
+        uint64_t invalidations = 0;  // 거래 변경으로 지운 페이지
+        size_t bytes = 0;
+        size_t entries = 0;
+        size_t budgetBytes = 0;
+    };
+
+    // 디코딩된 거래 목록 페이지의 LRU 캐시. 바이트 예산을 넘으면 가장 오래 안 쓴 페이지부터 버린다.
+    // 키는 (지갑, 커서, 페이지 크기, 누적 잔액 여부)이며 페이지 크기 0 은 지갑 전체 목록이다.
+    //  - 거래가 바뀌면 onChanged 로 그 (날짜, ID) 가 들어가는 페이지만 지운다.
+    //    누적 잔액이 붙은 페이지는 그보다 최신 행의 잔액도 바뀌므로 커서가 더 최신인 페이지를 모두 지운다.
+    //  - 읽기 커넥션은 마지막 커밋만 보므로 바깥 트랜잭션 안에서 바뀐 지갑은 그 트랜잭션이 끝날 때까지 캐시를 거치지 않고,
+    //    끝난 뒤 같은 범위를 한 번 더 지운다.
+    //  - 조회 전에 beginRead 로 받은 값을 put 에 넘기면, 조회하는 동안 지갑이 바뀐 경우 옛 스냅샷을 넣지 않는다.
+    //  - 스키마 백필이 Transactions 를 바꾼 묶음을 커밋하면 어느 페이지가 바뀌었는지 모르므로 전부 지운다.
+    class TransactionPageCache {
+    public:
+        static constexpr size_t DEFAULT_BUDGET_BYTES = 4 * 1024 * 1024;
+
+        struct Key {
+            int walletId;
+            int64_t afterDate; // 첫 페이지는 0
+            int afterId;       // 첫 페이지는 0
+            int limit;         // 0 이면 전체 목록
+            bool withRunningBalances;
+
+            bool operator==(const Key& other) const;
+        };
+
+    private:
+        struct KeyHash {
+            size_t operator()(const Key& key) const;
+        };
+
+        struct Entry {
+            Key key;
+            TransactionPage page;
+            size_t bytes;
+            bool hasUpper;              // false 면 위쪽 끝이 없음 (첫 페이지, 전체 목록)
+            bool hasLower;              // false 면 아래쪽 끝이 없음 (마지막 페이지, 전체 목록)
+            int64_t lowerDate;
+            int lowerId;
+        };
+
+        struct Change {
+            int64_t date;
+            int id;
+        };
+
+        DatabaseHelper& dbHelper; // 쓰기 커넥션 (트랜잭션 상태 확인용)
+        mutable std::mutex mutex;
+        size_t budgetBytes;
+        size_t bytes = 0;
+        std::list<Entry> lru; // 앞쪽이 최근
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+        std::unordered_map<int, std::vector<std::list<Entry>::iterator>> byWallet;
+
+        uint64_t version = 0;                           // 무효화할 때마다 증가
+        uint64_t clearedAt = 0;
+        std::unordered_map<int, uint64_t> changedAt;    // 지갑별 마지막 무효화 version
+        std::unordered_map<int, std::vector<Change>> pending; // 바깥 트랜잭션 안에서 바뀐 지갑
+        uint64_t pendingSince = 0;                      // pending 을 모을 때의 getOuterTransactionEnds()
+        uint64_t backfillSeen;                          // 마지막으로 확인한 getBackfillChanges()
+
+        PageCacheStats stats;
+
+        static size_t estimateBytes(const TransactionPage& page);
+        void flushPendingLocked();
+        void clearLocked();
+        void invalidateLocked(int walletId, int64_t date, int id);
+        void eraseLocked(std::list<Entry>::iterator it);
+        void evictLocked();
+
+    public:
+        explicit TransactionPageCache(DatabaseHelper& writer, size_t budgetBytes = DEFAULT_BUDGET_BYTES);
+
+        bool get(const Key& key, TransactionPage& page); // 적중하면 복사해 준다
+        uint64_t beginRead(); // 조회 시작 전에 호출해 put 에 넘긴다
+        void put(const Key& key, TransactionPage page, uint64_t readVersion);
+
+        // 커밋된 거래 변경. 쓰기 커넥션을 잡은 스레드에서 커밋 직후 호출한다
+        void onChanged(int walletId, int64_t date, int id);
+        void clear();
+
+        void setBudget(size_t bytes); // 0 이면 캐시를 쓰지 않는다
+        PageCacheStats getStats(bool reset);
+    };
+
+}
+
+#endif //POCKETMONEYAPP_TRANSACTIONPAGECACHE_H
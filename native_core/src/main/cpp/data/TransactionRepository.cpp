@@ -3,28 +3,178 @@
 //
 
 #include "TransactionRepository.h"
+#include "LatencyMetrics.h"
 #include <sqlite3.h>
 #include <chrono>
+#include <cctype>
+#include <climits>
 #include <iomanip>
 #include <sstream>
-#include <android/log.h>
+#include <thread>
+#include <unordered_map>
+#include "../platform/Log.h"
 
 namespace data {
 
-    TransactionRepository::TransactionRepository(DatabaseHelper& helper) : dbHelper(helper) {
+    static const char* const LIST_BY_WALLET_SQL =
+            "SELECT id, wallet_id, description, amount, type, TransactionDate FROM transactions WHERE wallet_id = ? ORDER BY TransactionDate DESC, id DESC;";
+
+    static const char* const FIRST_PAGE_SQL =
+            "SELECT id, wallet_id, description, amount, type, TransactionDate FROM transactions WHERE wallet_id = ? "
+            "ORDER BY TransactionDate DESC, id DESC LIMIT ?;";
+
+    static const char* const NEXT_PAGE_SQL =
+            "SELECT id, wallet_id, description, amount, type, TransactionDate FROM transactions WHERE wallet_id = ? "
+            "AND (TransactionDate, id) < (?, ?) ORDER BY TransactionDate DESC, id DESC LIMIT ?;";
+
+    // 스키마 버전 2 백필 중에는 아직 옮겨지지 않은 거래가 Transactions_legacy 에 TEXT 날짜로 남아 있다.
+    // 백필과 같은 식으로 날짜를 바꿔 합친다. 옛 테이블에는 지갑 인덱스가 없어 백필이 끝날 때까지만 감수한다
+    static const char* const LEGACY_TABLE = "Transactions_legacy";
+
+    static const char* const BY_ID_WITH_LEGACY_SQL =
+            "SELECT ID, wallet_id, Description, Amount, Type, TransactionDate FROM Transactions WHERE ID = ?1 "
+            "UNION ALL SELECT ID, wallet_id, Description, Amount, Type, COALESCE(CAST(strftime('%s', TransactionDate) AS INTEGER), 0) "
+            "FROM Transactions_legacy WHERE ID = ?1;";
+
+    static const char* const LIST_BY_WALLET_WITH_LEGACY_SQL =
+            "SELECT id, wallet_id, description, amount, type, TransactionDate FROM transactions WHERE wallet_id = ?1 "
+            "UNION ALL SELECT ID, wallet_id, Description, Amount, Type, COALESCE(CAST(strftime('%s', TransactionDate) AS INTEGER), 0) "
+            "FROM Transactions_legacy WHERE wallet_id = ?1 ORDER BY 6 DESC, 1 DESC;";
+
+    static const char* const FIRST_PAGE_WITH_LEGACY_SQL =
+            "SELECT id, wallet_id, description, amount, type, TransactionDate FROM transactions WHERE wallet_id = ?1 "
+            "UNION ALL SELECT ID, wallet_id, Description, Amount, Type, COALESCE(CAST(strftime('%s', TransactionDate) AS INTEGER), 0) "
+            "FROM Transactions_legacy WHERE wallet_id = ?1 ORDER BY 6 DESC, 1 DESC LIMIT ?2;";
+
+    static const char* const NEXT_PAGE_WITH_LEGACY_SQL =
+            "SELECT id, wallet_id, description, amount, type, TransactionDate FROM transactions WHERE wallet_id = ?1 "
+            "AND (TransactionDate, id) < (?2, ?3) "
+            "UNION ALL SELECT ID, wallet_id, Description, Amount, Type, COALESCE(CAST(strftime('%s', TransactionDate) AS INTEGER), 0) "
+            "FROM Transactions_legacy WHERE wallet_id = ?1 "
+            "AND (COALESCE(CAST(strftime('%s', TransactionDate) AS INTEGER), 0), ID) < (?2, ?3) "
+            "ORDER BY 6 DESC, 1 DESC LIMIT ?4;";
+
+    // rank 는 FTS5 의 bm25 점수. 같은 점수 안에서는 ID 로 순서를 고정해 키셋 커서로 쓴다.
+    // 색인 안에서 순위를 매겨 limit 건만 고른 뒤 Transactions 와 조인한다
+    static const char* const SEARCH_FIRST_SQL =
+            "SELECT t.id, t.wallet_id, t.description, t.amount, t.type, t.TransactionDate, f.rank FROM "
+            "(SELECT rowid, rank FROM TransactionsFts WHERE TransactionsFts MATCH ?1 ORDER BY rank, rowid LIMIT ?2) f "
+            "JOIN Transactions t ON t.id = f.rowid ORDER BY f.rank, t.id;";
+
+    static const char* const SEARCH_NEXT_SQL =
+            "SELECT t.id, t.wallet_id, t.description, t.amount, t.type, t.TransactionDate, f.rank FROM "
+            "(SELECT rowid, rank FROM TransactionsFts WHERE TransactionsFts MATCH ?1 "
+            "AND (rank > ?3 OR (rank = ?3 AND rowid > ?4)) ORDER BY rank, rowid LIMIT ?2) f "
+            "JOIN Transactions t ON t.id = f.rowid ORDER BY f.rank, t.id;";
+
+    namespace {
+
+        const size_t INSERT_CHUNK_ROWS = 64; // 다중 행 INSERT 한 문장의 최대 행 수 (바인딩 320개)
+
+        const int OPTIMISTIC_PAGE_READS = 3; // 누적 잔액 페이지를 잠금 없이 읽어 보는 횟수
+
+        // 다중 행 INSERT. 검색 색인(FTS5)은 문장마다 세그먼트를 쓰므로 행마다 문장을 나누면 병합 비용이 커진다
+        const std::string& multiRowInsertSql(size_t rows) {
+            static const std::vector<std::string> sqls = [] {
+                std::vector<std::string> built(INSERT_CHUNK_ROWS + 1);
+                for (size_t n = 1; n <= INSERT_CHUNK_ROWS; n *= 2) {
+                    built[n] = "INSERT INTO Transactions (wallet_id, Description, Amount, Type, TransactionDate) VALUES (?, ?, ?, ?, ?)";
+                    for (size_t i = 1; i < n; ++i) built[n] += ", (?, ?, ?, ?, ?)";
+                    built[n] += ';';
+                }
+                return built;
+            }();
+            return sqls[rows];
+        }
+
+        // 옛 테이블이 있으면 legacySql, 없으면 sql 을 준비하고 bind 후 첫 step 까지 실행한다.
+        // 테이블 확인과 첫 step 사이에 백필의 마지막 묶음이 옛 테이블을 지웠다면 sql 로 다시 실행한다.
+        // 실패하면 nullptr, 성공하면 첫 step 결과를 rc 에 담은 문장을 돌려준다 (호출 측이 releaseStatement)
+        sqlite3_stmt* stepFirstRow(DatabaseHelper& helper, const std::string& sql, const std::string& legacySql,
+                                   const std::function<void(sqlite3_stmt*)>& bind, int& rc) {
+            bool legacy = helper.tableExists(LEGACY_TABLE);
+            for (;;) {
+                sqlite3_stmt* stmt = helper.prepareCached(legacy ? legacySql : sql);
+                if (!stmt) return nullptr;
+                bind(stmt);
+                rc = sqlite3_step(stmt);
+                if (rc == SQLITE_ROW || rc == SQLITE_DONE || !legacy || helper.tableExists(LEGACY_TABLE)) {
+                    return stmt;
+                }
+                helper.releaseStatement(stmt);
+                legacy = false;
+            }
+        }
+
+        // 사용자 입력을 FTS5 질의로 바꾼다. 단어마다 큰따옴표로 감싸 연산자 문법을 막고 Description 에서 접두어(*) 검색한다.
+        // 지갑 조건은 wallet_id 컬럼 토큰으로 붙인다. 예: "스타벅 커피", 3 -> Description : "스타벅"* Description : "커피"* wallet_id : "3"
+        std::string buildMatchQuery(const std::string& query, int walletId) {
+            std::string match;
+            size_t i = 0;
+            while (i < query.size()) {
+                while (i < query.size() && std::isspace(static_cast<unsigned char>(query[i]))) ++i;
+                if (i == query.size()) break;
+                if (!match.empty()) match += ' ';
+                match += "Description : \"";
+                for (; i < query.size() && !std::isspace(static_cast<unsigned char>(query[i])); ++i) {
+                    if (query[i] == '"') match += '"';
+                    match += query[i];
+                }
+                match += "\"*";
+            }
+            if (!match.empty() && walletId > 0) {
+                match += " wallet_id : \"" + std::to_string(walletId) + "\"";
+            }
+            return match;
+        }
+
+    }
+
+    TransactionRepository::TransactionRepository(DatabaseHelper& helper)
+            : dbHelper(helper), connections(nullptr), balanceIndex(helper), pageCache(helper) {
         LOGD_REPO("TransactionRepository initialized.");
     }
 
+    TransactionRepository::TransactionRepository(ConnectionManager& connections)
+            : dbHelper(connections.writer()), connections(&connections), balanceIndex(connections.writer()),
+              pageCache(connections.writer()) {
+        LOGD_REPO("TransactionRepository initialized with %d read connections.", connections.getReaderCount());
+    }
+
+    std::unique_lock<std::recursive_mutex> TransactionRepository::lockWriter() {
+        return connections ? connections->lockWriter() : std::unique_lock<std::recursive_mutex>();
+    }
+
+    void TransactionRepository::recordInserted(const domain::Transaction& transaction) {
+        balanceIndex.onInserted(transaction.walletId, transaction.transactionDate, transaction.id, transaction.signedAmount());
+    }
+
+    void TransactionRepository::recordRemoved(const domain::Transaction& transaction) {
+        balanceIndex.onRemoved(transaction.walletId, transaction.transactionDate, transaction.id);
+    }
+
+    void TransactionRepository::onChanged(const domain::Transaction& transaction) {
+        pageCache.onChanged(transaction.walletId, transaction.transactionDate, transaction.id);
+    }
+
     bool TransactionRepository::createTransaction(domain::Transaction& transaction) {
+        ScopedLatencyTimer timer(Operation::CREATE_TRANSACTION);
         if (!dbHelper.getDb()) {
             LOGE_REPO("Database not open for createTransaction.");
             return false;
         }
 
-        sqlite3_stmt *stmt;
+        auto writeLock = lockWriter();
+
+        ScopedTransaction tx(dbHelper);
+        if (!tx.isActive()) {
+            LOGE_REPO("Failed to begin transaction for createTransaction.");
+            return false;
+        }
+
         const char* sql = "INSERT INTO Transactions (wallet_id, Description, Amount, Type, TransactionDate) VALUES (?, ?, ?, ?, ?);";
-        int rc = sqlite3_prepare_v2(dbHelper.getDb(), sql, -1, &stmt, 0);
-        if (rc != SQLITE_OK) {
+        sqlite3_stmt *stmt = dbHelper.prepareCached(sql);
+        if (!stmt) {
             LOGE_REPO("SQL error (createTransaction prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
             return false;
         }
@@ -33,97 +183,249 @@ namespace data {
         sqlite3_bind_text(stmt, 2, transaction.description.c_str(), -1, SQLITE_TRANSIENT);
         sqlite3_bind_int64(stmt, 3, transaction.amount);
         sqlite3_bind_int(stmt, 4, static_cast<int>(transaction.type));
-        sqlite3_bind_text(stmt, 5, transaction.transactionDate.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(stmt, 5, transaction.transactionDate);
 
-        rc = sqlite3_step(stmt);
+        int rc = sqlite3_step(stmt);
         if (rc != SQLITE_DONE) {
             LOGE_REPO("SQL error (createTransaction step): %s", sqlite3_errmsg(dbHelper.getDb()));
-            sqlite3_finalize(stmt);
+            dbHelper.releaseStatement(stmt);
             return false;
         }
 
         transaction.id = static_cast<int>(sqlite3_last_insert_rowid(dbHelper.getDb()));
-        sqlite3_finalize(stmt);
+        dbHelper.releaseStatement(stmt);
+
+        MonthlyTotalsAccumulator monthlyDeltas;
+        monthlyDeltas.add(transaction.walletId, transaction.transactionDate, static_cast<int>(transaction.type), transaction.amount);
+        if (!applyBalanceDelta(transaction.walletId, transaction.signedAmount()) || !applyMonthlyTotals(dbHelper, monthlyDeltas)) {
+            return false;
+        }
+        recordInserted(transaction);
+        if (!tx.commit()) {
+            LOGE_REPO("SQL error (createTransaction commit): %s", sqlite3_errmsg(dbHelper.getDb()));
+            return false;
+        }
+        onChanged(transaction);
         LOGD_REPO("Transaction created successfully with ID: %d", transaction.id);
         return true;
     }
 
+    bool TransactionRepository::createTransactions(std::vector<domain::Transaction>& transactions) {
+        ScopedLatencyTimer timer(Operation::CREATE_TRANSACTIONS);
+        if (!dbHelper.getDb()) {
+            LOGE_REPO("Database not open for createTransactions.");
+            return false;
+        }
+        if (transactions.empty()) return true;
+
+        auto writeLock = lockWriter();
+
+        ScopedTransaction tx(dbHelper);
+        if (!tx.isActive()) {
+            LOGE_REPO("Failed to begin transaction for createTransactions.");
+            return false;
+        }
+
+        std::unordered_map<int, long long> balanceDeltas; // wallet_id -> 누적 증감분
+        MonthlyTotalsAccumulator monthlyDeltas;            // (wallet_id, yyyymm) -> 누적 증감분
+        size_t next = 0;
+        while (next < transactions.size()) {
+            // 64, 32, ... 1 행 문장으로 나눠 넣는다 (준비된 문장은 최대 7개)
+            size_t chunk = INSERT_CHUNK_ROWS;
+            while (chunk > transactions.size() - next) chunk /= 2;
+            sqlite3_stmt *stmt = dbHelper.prepareCached(multiRowInsertSql(chunk));
+            if (!stmt) {
+                LOGE_REPO("SQL error (createTransactions prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
+                return false;
+            }
+            int param = 1;
+            for (size_t i = next; i < next + chunk; ++i) {
+                const domain::Transaction& transaction = transactions[i];
+                sqlite3_bind_int(stmt, param++, transaction.walletId);
+                sqlite3_bind_text(stmt, param++, transaction.description.c_str(), -1, SQLITE_STATIC);
+                sqlite3_bind_int64(stmt, param++, transaction.amount);
+                sqlite3_bind_int(stmt, param++, static_cast<int>(transaction.type));
+                sqlite3_bind_int64(stmt, param++, transaction.transactionDate);
+            }
+            int rc = sqlite3_step(stmt);
+            if (rc != SQLITE_DONE) {
+                LOGE_REPO("SQL error (createTransactions step): %s", sqlite3_errmsg(dbHelper.getDb()));
+                dbHelper.releaseStatement(stmt);
+                return false;
+            }
+            dbHelper.releaseStatement(stmt);
+
+            // 한 문장 안의 AUTOINCREMENT ID 는 연속이고 마지막 행이 last_insert_rowid 다 (쓰기 잠금 안)
+            sqlite3_int64 firstId = sqlite3_last_insert_rowid(dbHelper.getDb()) - static_cast<sqlite3_int64>(chunk) + 1;
+            for (size_t i = 0; i < chunk; ++i) {
+                domain::Transaction& transaction = transactions[next + i];
+                transaction.id = static_cast<int>(firstId + static_cast<sqlite3_int64>(i));
+                balanceDeltas[transaction.walletId] += transaction.signedAmount();
+                monthlyDeltas.add(transaction.walletId, transaction.transactionDate, static_cast<int>(transaction.type), transaction.amount);
+            }
+            next += chunk;
+        }
+
+        for (const auto& entry : balanceDeltas) {
+            if (!applyBalanceDelta(entry.first, entry.second)) {
+                return false;
+            }
+        }
+        if (!applyMonthlyTotals(dbHelper, monthlyDeltas)) {
+            return false;
+        }
+        // 과거 날짜가 섞인 대량 삽입(가져오기)도 지갑마다 한 번만 재구성하도록 묶어서 넘긴다
+        std::vector<BalanceIndex::Insertion> insertions;
+        insertions.reserve(transactions.size());
+        for (const domain::Transaction& transaction : transactions) {
+            insertions.push_back({transaction.walletId, transaction.transactionDate, transaction.id, transaction.signedAmount()});
+        }
+        balanceIndex.onInsertedBatch(insertions);
+        if (!tx.commit()) {
+            LOGE_REPO("SQL error (createTransactions commit): %s", sqlite3_errmsg(dbHelper.getDb()));
+            return false;
+        }
+        for (const domain::Transaction& transaction : transactions) {
+            onChanged(transaction);
+        }
+        LOGD_REPO("%zu transactions created across %zu wallets.", transactions.size(), balanceDeltas.size());
+        return true;
+    }
+
     domain::Transaction TransactionRepository::getTransactionById(int id) {
+        ScopedLatencyTimer timer(Operation::GET_TRANSACTION_BY_ID);
+        ReadConnection read(connections, dbHelper);
+        return readTransactionById(read.helper(), id);
+    }
+
+    domain::Transaction TransactionRepository::readTransactionById(DatabaseHelper& helper, int id) {
         domain::Transaction transaction;
-        if (!dbHelper.getDb()) {
+        if (!helper.getDb()) {
             LOGE_REPO("Database not open for getTransactionById.");
             return transaction;
         }
 
-        sqlite3_stmt *stmt;
         const char* sql = "SELECT ID, wallet_id, Description, Amount, Type, TransactionDate FROM Transactions WHERE ID = ?;";
-        int rc = sqlite3_prepare_v2(dbHelper.getDb(), sql, -1, &stmt, 0);
-        if (rc != SQLITE_OK) {
-            LOGE_REPO("SQL error (getTransactionById prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
+        int rc;
+        sqlite3_stmt *stmt = stepFirstRow(helper, sql, BY_ID_WITH_LEGACY_SQL,
+                                          [id](sqlite3_stmt* s) { sqlite3_bind_int(s, 1, id); }, rc);
+        if (!stmt) {
+            LOGE_REPO("SQL error (getTransactionById prepare): %s", sqlite3_errmsg(helper.getDb()));
             return transaction;
         }
 
-        sqlite3_bind_int(stmt, 1, id);
-
-        if (sqlite3_step(stmt) == SQLITE_ROW) {
+        if (rc == SQLITE_ROW) {
             transaction.id = sqlite3_column_int(stmt, 0);
             transaction.walletId = sqlite3_column_int(stmt, 1);
-            transaction.description = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+            const char* description = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+            transaction.description = description ? description : ""; // Description 은 NULL 허용
             transaction.amount = sqlite3_column_int64(stmt, 3);
             transaction.type = static_cast<domain::TransactionType>(sqlite3_column_int(stmt, 4));
-            transaction.transactionDate = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 5));
+            transaction.transactionDate = sqlite3_column_int64(stmt, 5);
             LOGD_REPO("Transaction ID %d found.", transaction.id);
         } else {
             LOGD_REPO("Transaction ID %d not found.", id);
         }
 
-        sqlite3_finalize(stmt);
+        helper.releaseStatement(stmt);
         return transaction;
     }
 
+    bool TransactionRepository::promoteLegacyTransaction(int id) {
+        if (!dbHelper.tableExists(LEGACY_TABLE)) return true;
+        if (!SchemaMigrator(dbHelper).keepUnparsableLegacyDates(id, id)) return false;
+        // 백필과 같은 변환으로 한 행만 옮긴다. 옛 테이블에서 지우므로 백필이 다시 옮기지 않는다
+        const char* sqls[] = {
+                "INSERT INTO Transactions (ID, wallet_id, Description, Amount, Type, TransactionDate) "
+                "SELECT ID, wallet_id, Description, Amount, Type, COALESCE(CAST(strftime('%s', TransactionDate) AS INTEGER), 0) "
+                "FROM Transactions_legacy WHERE ID = ?;",
+                "DELETE FROM Transactions_legacy WHERE ID = ?;"
+        };
+        for (const char* sql : sqls) {
+            sqlite3_stmt* stmt = dbHelper.prepareCached(sql);
+            if (!stmt) {
+                LOGE_REPO("SQL error (promoteLegacyTransaction prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
+                return false;
+            }
+            sqlite3_bind_int(stmt, 1, id);
+            int rc = sqlite3_step(stmt);
+            dbHelper.releaseStatement(stmt);
+            if (rc != SQLITE_DONE) {
+                LOGE_REPO("SQL error (promoteLegacyTransaction step): %s", sqlite3_errmsg(dbHelper.getDb()));
+                return false;
+            }
+        }
+        return true;
+    }
+
     std::vector<domain::Transaction> TransactionRepository::getTransactionsByWallet(int walletId, const std::string& orderBy) {
+        ScopedLatencyTimer timer(Operation::GET_TRANSACTIONS_BY_WALLET);
         std::vector<domain::Transaction> transactions;
-        if (!dbHelper.getDb()) {
+        ReadConnection read(connections, dbHelper);
+        DatabaseHelper& helper = read.helper();
+        if (!helper.getDb()) {
             LOGE_REPO("Database not open for getTransactionsByWallet.");
             return transactions;
         }
 
-        sqlite3_stmt *stmt;
         std::string sql = "SELECT ID, wallet_id, Description, Amount, Type, TransactionDate FROM Transactions WHERE wallet_id = ? ORDER BY " + orderBy + ";";
-        int rc = sqlite3_prepare_v2(dbHelper.getDb(), sql.c_str(), -1, &stmt, 0);
-        if (rc != SQLITE_OK) {
-            LOGE_REPO("SQL error (getTransactionsByWallet prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
+        std::string legacySql =
+                "SELECT * FROM (SELECT ID, wallet_id, Description, Amount, Type, TransactionDate FROM Transactions WHERE wallet_id = ?1 "
+                "UNION ALL SELECT ID, wallet_id, Description, Amount, Type, COALESCE(CAST(strftime('%s', TransactionDate) AS INTEGER), 0) "
+                "FROM Transactions_legacy WHERE wallet_id = ?1) ORDER BY " + orderBy + ";";
+        int rc;
+        sqlite3_stmt *stmt = stepFirstRow(helper, sql, legacySql,
+                                          [walletId](sqlite3_stmt* s) { sqlite3_bind_int(s, 1, walletId); }, rc);
+        if (!stmt) {
+            LOGE_REPO("SQL error (getTransactionsByWallet prepare): %s", sqlite3_errmsg(helper.getDb()));
             return transactions;
         }
 
-        sqlite3_bind_int(stmt, 1, walletId);
-
-        while (sqlite3_step(stmt) == SQLITE_ROW) {
+        for (; rc == SQLITE_ROW; rc = sqlite3_step(stmt)) {
             domain::Transaction transaction;
             transaction.id = sqlite3_column_int(stmt, 0);
             transaction.walletId = sqlite3_column_int(stmt, 1);
-            transaction.description = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+            const char* description = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+            transaction.description = description ? description : ""; // Description 은 NULL 허용
             transaction.amount = sqlite3_column_int64(stmt, 3);
             transaction.type = static_cast<domain::TransactionType>(sqlite3_column_int(stmt, 4));
-            transaction.transactionDate = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 5));
+            transaction.transactionDate = sqlite3_column_int64(stmt, 5);
             transactions.push_back(transaction);
         }
 
-        sqlite3_finalize(stmt);
+        helper.releaseStatement(stmt);
         LOGD_REPO("Retrieved %zu transactions for wallet_id %d.", transactions.size(), walletId);
         return transactions;
     }
 
     bool TransactionRepository::updateTransaction(const domain::Transaction& transaction) {
+        ScopedLatencyTimer timer(Operation::UPDATE_TRANSACTION);
         if (!dbHelper.getDb()) {
             LOGE_REPO("Database not open for updateTransaction.");
             return false;
         }
 
-        sqlite3_stmt *stmt;
+        auto writeLock = lockWriter();
+
+        ScopedTransaction tx(dbHelper);
+        if (!tx.isActive()) {
+            LOGE_REPO("Failed to begin transaction for updateTransaction.");
+            return false;
+        }
+
+        if (!promoteLegacyTransaction(transaction.id)) {
+            return false;
+        }
+        // 잔액 증감 계산을 위해 변경 전 행을 같은 트랜잭션 안에서 읽는다
+        domain::Transaction previous = readTransactionById(dbHelper, transaction.id);
+        if (previous.id == 0) {
+            LOGE_REPO("Transaction ID %d not found for updateTransaction.", transaction.id);
+            return false;
+        }
+
         const char* sql = "UPDATE Transactions SET wallet_id = ?, Description = ?, Amount = ?, Type = ?, TransactionDate = ? WHERE ID = ?;";
-        int rc = sqlite3_prepare_v2(dbHelper.getDb(), sql, -1, &stmt, 0);
-        if (rc != SQLITE_OK) {
+        sqlite3_stmt *stmt = dbHelper.prepareCached(sql);
+        if (!stmt) {
             LOGE_REPO("SQL error (updateTransaction prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
             return false;
         }
@@ -132,31 +434,70 @@ namespace data {
         sqlite3_bind_text(stmt, 2, transaction.description.c_str(), -1, SQLITE_TRANSIENT);
         sqlite3_bind_int64(stmt, 3, transaction.amount);
         sqlite3_bind_int(stmt, 4, static_cast<int>(transaction.type));
-        sqlite3_bind_text(stmt, 5, transaction.transactionDate.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(stmt, 5, transaction.transactionDate);
         sqlite3_bind_int(stmt, 6, transaction.id);
 
-        rc = sqlite3_step(stmt);
+        int rc = sqlite3_step(stmt);
         if (rc != SQLITE_DONE) {
             LOGE_REPO("SQL error (updateTransaction step): %s", sqlite3_errmsg(dbHelper.getDb()));
-            sqlite3_finalize(stmt);
+            dbHelper.releaseStatement(stmt);
             return false;
         }
 
-        sqlite3_finalize(stmt);
+        dbHelper.releaseStatement(stmt);
+
+        bool balanced;
+        if (previous.walletId == transaction.walletId) {
+            balanced = applyBalanceDelta(transaction.walletId, transaction.signedAmount() - previous.signedAmount());
+        } else {
+            balanced = applyBalanceDelta(previous.walletId, -previous.signedAmount()) &&
+                       applyBalanceDelta(transaction.walletId, transaction.signedAmount());
+        }
+        MonthlyTotalsAccumulator monthlyDeltas;
+        monthlyDeltas.add(previous.walletId, previous.transactionDate, static_cast<int>(previous.type), previous.amount, -1);
+        monthlyDeltas.add(transaction.walletId, transaction.transactionDate, static_cast<int>(transaction.type), transaction.amount);
+        if (!balanced || !applyMonthlyTotals(dbHelper, monthlyDeltas)) {
+            return false;
+        }
+        recordRemoved(previous);
+        recordInserted(transaction);
+        if (!tx.commit()) {
+            LOGE_REPO("SQL error (updateTransaction commit): %s", sqlite3_errmsg(dbHelper.getDb()));
+            return false;
+        }
+        onChanged(previous);
+        onChanged(transaction);
         LOGD_REPO("Transaction ID %d updated successfully.", transaction.id);
         return true;
     }
 
     bool TransactionRepository::deleteTransaction(int id) {
+        ScopedLatencyTimer timer(Operation::DELETE_TRANSACTION);
         if (!dbHelper.getDb()) {
             LOGE_REPO("Database not open for deleteTransaction.");
             return false;
         }
 
-        sqlite3_stmt *stmt;
+        auto writeLock = lockWriter();
+
+        ScopedTransaction tx(dbHelper);
+        if (!tx.isActive()) {
+            LOGE_REPO("Failed to begin transaction for deleteTransaction.");
+            return false;
+        }
+
+        if (!promoteLegacyTransaction(id)) {
+            return false;
+        }
+        domain::Transaction previous = readTransactionById(dbHelper, id);
+        if (previous.id == 0) {
+            LOGD_REPO("Transaction ID %d not found or deletion failed.", id);
+            return false;
+        }
+
         const char* sql = "DELETE FROM Transactions WHERE ID = ?;";
-        int rc = sqlite3_prepare_v2(dbHelper.getDb(), sql, -1, &stmt, 0);
-        if (rc != SQLITE_OK) {
+        sqlite3_stmt *stmt = dbHelper.prepareCached(sql);
+        if (!stmt) {
             LOGE_REPO("SQL error (deleteTransaction prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
             return false;
         }
@@ -164,51 +505,71 @@ namespace data {
         sqlite3_bind_int(stmt, 1, id);
 
         int changes_before = sqlite3_total_changes(dbHelper.getDb()); // 변경 전 총 변화 수
-        rc = sqlite3_step(stmt);
+        int rc = sqlite3_step(stmt);
         if (rc != SQLITE_DONE) {
             LOGE_REPO("SQL error (deleteTransaction step): %s", sqlite3_errmsg(dbHelper.getDb()));
-            sqlite3_finalize(stmt);
+            dbHelper.releaseStatement(stmt);
             return false;
         }
         int changes_after = sqlite3_total_changes(dbHelper.getDb()); // 변경 후 총 변화 수
 
-        sqlite3_finalize(stmt);
+        dbHelper.releaseStatement(stmt);
 
-        if (changes_after > changes_before) { // 변화가 있었다면 성공
-            LOGD_REPO("Transaction ID %d deleted successfully.", id);
-            return true;
-        } else { // 변화가 없다면 (해당 ID가 없거나 실패)
+        if (changes_after <= changes_before) { // 변화가 없다면 (해당 ID가 없거나 실패)
             LOGD_REPO("Transaction ID %d not found or deletion failed.", id);
             return false;
         }
+
+        MonthlyTotalsAccumulator monthlyDeltas;
+        monthlyDeltas.add(previous.walletId, previous.transactionDate, static_cast<int>(previous.type), previous.amount, -1);
+        if (!applyBalanceDelta(previous.walletId, -previous.signedAmount()) || !applyMonthlyTotals(dbHelper, monthlyDeltas)) {
+            return false;
+        }
+        recordRemoved(previous);
+        if (!tx.commit()) {
+            LOGE_REPO("SQL error (deleteTransaction commit): %s", sqlite3_errmsg(dbHelper.getDb()));
+            return false;
+        }
+        onChanged(previous);
+        LOGD_REPO("Transaction ID %d deleted successfully.", id);
+        return true;
     }
 
     std::vector<domain::Transaction> TransactionRepository::getTransactionsByWalletId(int walletId) {
+        ScopedLatencyTimer timer(Operation::GET_TRANSACTIONS_BY_WALLET_ID);
+        TransactionPageCache::Key key{walletId, 0, 0, 0, false}; // 페이지 크기 0: 전체 목록
+        TransactionPage cached;
+        if (pageCache.get(key, cached)) {
+            return std::move(cached.transactions);
+        }
+        uint64_t readVersion = pageCache.beginRead();
+
         std::vector<domain::Transaction> transactions;
-        sqlite3* db = dbHelper.getDb();
+        ReadConnection read(connections, dbHelper);
+        DatabaseHelper& helper = read.helper();
+        sqlite3* db = helper.getDb();
         if (!db) {
             LOGE_REPO("Failed to get database connection for getting transactions by wallet ID.");
             return transactions; // 빈 벡터 반환
         }
 
-        std::string sql = "SELECT id, wallet_id, description, amount, type, TransactionDate FROM transactions WHERE wallet_id = ? ORDER BY TransactionDate DESC, id DESC;";
-        sqlite3_stmt* stmt;
-        int rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr);
-        if (rc != SQLITE_OK) {
+        int rc;
+        sqlite3_stmt* stmt = stepFirstRow(helper, LIST_BY_WALLET_SQL, LIST_BY_WALLET_WITH_LEGACY_SQL,
+                                          [walletId](sqlite3_stmt* s) { sqlite3_bind_int(s, 1, walletId); }, rc);
+        if (!stmt) {
             LOGE_REPO("Failed to prepare statement for get transactions by wallet ID: %s", sqlite3_errmsg(db));
             return transactions;
         }
 
-        sqlite3_bind_int(stmt, 1, walletId);
-
-        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        for (; rc == SQLITE_ROW; rc = sqlite3_step(stmt)) {
             domain::Transaction transaction;
             transaction.id = sqlite3_column_int(stmt, 0);
             transaction.walletId = sqlite3_column_int(stmt, 1);
-            transaction.description = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+            const char* description = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+            transaction.description = description ? description : ""; // Description 은 NULL 허용
             transaction.amount = sqlite3_column_int64(stmt, 3);
             transaction.type = static_cast<domain::TransactionType>(sqlite3_column_int(stmt, 4));
-            transaction.transactionDate = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 5));
+            transaction.transactionDate = sqlite3_column_int64(stmt, 5);
             transactions.push_back(transaction);
         }
 
@@ -216,9 +577,398 @@ namespace data {
             LOGE_REPO("Failed to execute statement for get transactions by wallet ID: %s", sqlite3_errmsg(db));
         }
 
-        sqlite3_finalize(stmt);
+        helper.releaseStatement(stmt);
+        if (rc == SQLITE_DONE) {
+            cached.transactions = transactions;
+            pageCache.put(key, std::move(cached), readVersion);
+        }
         LOGD_REPO("Retrieved %zu transactions for wallet ID %d.", transactions.size(), walletId);
         return transactions;
     }
 
-}
\ No newline at end of file
+    TransactionPage TransactionRepository::getTransactionsPage(int walletId, int64_t afterDate, int afterId, int limit,
+                                                               bool withRunningBalances) {
+        ScopedLatencyTimer timer(Operation::GET_TRANSACTIONS_PAGE);
+        TransactionPage page;
+        bool firstPage = afterId <= 0;
+        TransactionPageCache::Key key{walletId, firstPage ? 0 : afterDate, firstPage ? 0 : afterId, limit, withRunningBalances};
+        if (limit > 0 && pageCache.get(key, page)) {
+            return page;
+        }
+        uint64_t readVersion = pageCache.beginRead();
+
+        // 행은 읽기 커넥션의 스냅샷, 첫 잔액은 메모리 색인에서 오므로 그 사이 바깥 트랜잭션이 끝나면 다시 읽는다.
+        // 커밋이 계속 겹치면 마지막에는 쓰기 잠금을 잡아 새 커밋을 막고 읽는다
+        bool ok = false;
+        for (int attempt = 0;; ++attempt) {
+            std::unique_lock<std::recursive_mutex> writeLock;
+            if (withRunningBalances && attempt == OPTIMISTIC_PAGE_READS) {
+                writeLock = lockWriter();
+            }
+            uint64_t endSequence = dbHelper.getOuterEndSequence();
+            if (withRunningBalances && !writeLock && (endSequence & 1)) {
+                std::this_thread::yield(); // 바깥 COMMIT 이 진행 중
+                continue;
+            }
+
+            page = TransactionPage();
+            if (limit > 0) {
+                page.transactions.reserve(limit);
+            }
+            ok = scanTransactionsPage(walletId, afterDate, afterId, limit, [&page](const TransactionRowView& row) {
+                domain::Transaction transaction;
+                transaction.id = row.id;
+                transaction.walletId = row.walletId;
+                transaction.description.assign(row.description, row.descriptionBytes);
+                transaction.amount = row.amount;
+                transaction.type = static_cast<domain::TransactionType>(row.type);
+                transaction.transactionDate = row.transactionDate;
+                page.transactions.push_back(std::move(transaction));
+                return true;
+            }, page.hasMore);
+
+            if (!page.transactions.empty()) {
+                page.nextDate = page.transactions.back().transactionDate;
+                page.nextId = page.transactions.back().id;
+            }
+
+            // 목록은 최신순이므로 다음 행의 잔액은 앞 행의 잔액에서 앞 행 금액을 뺀 값이다
+            long long balance = 0;
+            if (withRunningBalances && !page.transactions.empty() &&
+                balanceThrough(walletId, page.transactions.front().transactionDate, page.transactions.front().id, balance)) {
+                page.runningBalances.reserve(page.transactions.size());
+                for (const domain::Transaction& transaction : page.transactions) {
+                    page.runningBalances.push_back(balance);
+                    balance -= transaction.signedAmount();
+                }
+            }
+            if (!withRunningBalances || writeLock || dbHelper.getOuterEndSequence() == endSequence) {
+                break;
+            }
+        }
+        // 누적 잔액을 못 구한 페이지는 다음에 다시 시도하도록 넣지 않는다
+        if (ok && limit > 0 && (!withRunningBalances || page.runningBalances.size() == page.transactions.size())) {
+            pageCache.put(key, page, readVersion);
+        }
+        LOGD_REPO("Retrieved page of %zu transactions for wallet ID %d (hasMore: %d).", page.transactions.size(), walletId, page.hasMore);
+        return page;
+    }
+
+    bool TransactionRepository::scanTransactionsPage(int walletId, int64_t afterDate, int afterId, int limit,
+                                                     const TransactionRowVisitor& visitor, bool& hasMore) {
+        ScopedLatencyTimer timer(Operation::SCAN_TRANSACTIONS_PAGE);
+        hasMore = false;
+        ReadConnection read(connections, dbHelper);
+        DatabaseHelper& helper = read.helper();
+        sqlite3* db = helper.getDb();
+        if (!db) {
+            LOGE_REPO("Database not open for scanTransactionsPage.");
+            return false;
+        }
+        if (limit <= 0) {
+            LOGE_REPO("Invalid page size %d for scanTransactionsPage.", limit);
+            return false;
+        }
+
+        bool firstPage = afterId <= 0;
+        // 다음 페이지 존재 여부를 알기 위해 한 건 더 조회한다
+        int rc;
+        sqlite3_stmt* stmt = stepFirstRow(helper, firstPage ? FIRST_PAGE_SQL : NEXT_PAGE_SQL,
+                                          firstPage ? FIRST_PAGE_WITH_LEGACY_SQL : NEXT_PAGE_WITH_LEGACY_SQL,
+                                          [=](sqlite3_stmt* s) {
+            int param = 1;
+            sqlite3_bind_int(s, param++, walletId);
+            if (!firstPage) {
+                sqlite3_bind_int64(s, param++, afterDate);
+                sqlite3_bind_int(s, param++, afterId);
+            }
+            sqlite3_bind_int(s, param, limit + 1);
+        }, rc);
+        if (!stmt) {
+            LOGE_REPO("SQL error (scanTransactionsPage prepare): %s", sqlite3_errmsg(db));
+            return false;
+        }
+
+        int visited = 0;
+        for (; rc == SQLITE_ROW; rc = sqlite3_step(stmt)) {
+            if (visited == limit) {
+                hasMore = true;
+                break;
+            }
+            TransactionRowView row;
+            row.id = sqlite3_column_int(stmt, 0);
+            row.walletId = sqlite3_column_int(stmt, 1);
+            row.description = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+            row.descriptionBytes = sqlite3_column_bytes(stmt, 2);
+            if (!row.description) row.description = "";
+            row.amount = sqlite3_column_int64(stmt, 3);
+            row.type = sqlite3_column_int(stmt, 4);
+            row.transactionDate = sqlite3_column_int64(stmt, 5);
+            ++visited;
+            if (!visitor(row)) {
+                rc = SQLITE_DONE;
+                break;
+            }
+        }
+
+        bool ok = rc == SQLITE_DONE || rc == SQLITE_ROW;
+        if (!ok) {
+            LOGE_REPO("SQL error (scanTransactionsPage step): %s", sqlite3_errmsg(db));
+        }
+        helper.releaseStatement(stmt);
+        return ok;
+    }
+
+    TransactionSearchPage TransactionRepository::searchTransactions(const std::string& query, int walletId, int limit,
+                                                                    double afterRank, int afterId) {
+        ScopedLatencyTimer timer(Operation::SEARCH_TRANSACTIONS);
+        TransactionSearchPage page;
+        if (limit <= 0) {
+            LOGE_REPO("Invalid page size %d for searchTransactions.", limit);
+            return page;
+        }
+        std::string match = buildMatchQuery(query, walletId);
+        if (match.empty()) {
+            return page;
+        }
+
+        ReadConnection read(connections, dbHelper);
+        DatabaseHelper& helper = read.helper();
+        sqlite3* db = helper.getDb();
+        if (!db) {
+            LOGE_REPO("Database not open for searchTransactions.");
+            return page;
+        }
+        bool firstPage = afterId <= 0;
+        sqlite3_stmt* stmt = helper.prepareCached(firstPage ? SEARCH_FIRST_SQL : SEARCH_NEXT_SQL);
+        if (!stmt) {
+            LOGE_REPO("SQL error (searchTransactions prepare): %s", sqlite3_errmsg(db));
+            return page;
+        }
+
+        sqlite3_bind_text(stmt, 1, match.c_str(), static_cast<int>(match.size()), SQLITE_STATIC);
+        sqlite3_bind_int(stmt, 2, limit + 1); // 다음 페이지 존재 여부 확인용 한 건
+        if (!firstPage) {
+            sqlite3_bind_double(stmt, 3, afterRank);
+            sqlite3_bind_int(stmt, 4, afterId);
+        }
+        page.transactions.reserve(limit);
+
+        int rc;
+        double lastRank = 0;
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+            if (static_cast<int>(page.transactions.size()) == limit) {
+                page.hasMore = true;
+                break;
+            }
+            domain::Transaction transaction;
+            transaction.id = sqlite3_column_int(stmt, 0);
+            transaction.walletId = sqlite3_column_int(stmt, 1);
+            const char* description = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+            if (description) transaction.description.assign(description, sqlite3_column_bytes(stmt, 2));
+            transaction.amount = sqlite3_column_int64(stmt, 3);
+            transaction.type = static_cast<domain::TransactionType>(sqlite3_column_int(stmt, 4));
+            transaction.transactionDate = sqlite3_column_int64(stmt, 5);
+            lastRank = sqlite3_column_double(stmt, 6);
+            page.transactions.push_back(std::move(transaction));
+        }
+        if (rc != SQLITE_DONE && rc != SQLITE_ROW) {
+            LOGE_REPO("SQL error (searchTransactions step): %s", sqlite3_errmsg(db));
+        }
+        helper.releaseStatement(stmt);
+
+        if (!page.transactions.empty()) {
+            page.nextRank = lastRank;
+            page.nextId = page.transactions.back().id;
+        }
+        LOGD_REPO("Search matched %zu transactions (hasMore: %d).", page.transactions.size(), page.hasMore);
+        return page;
+    }
+
+    bool TransactionRepository::balanceAt(int walletId, int64_t date, long long& balance) {
+        ScopedLatencyTimer timer(Operation::BALANCE_AT);
+        return balanceThrough(walletId, date, INT_MAX, balance);
+    }
+
+    bool TransactionRepository::balanceThrough(int walletId, int64_t date, int id, long long& balance) {
+        if (balanceIndex.balanceThrough(walletId, date, id, balance)) {
+            return true;
+        }
+        // 색인을 만드는 동안 다른 커밋이 끼어들면 그 변경이 빠지므로 쓰기 잠금 안에서 읽고 바로 조회한다.
+        // 이 스레드가 연 트랜잭션 안이면 쓰기 커넥션은 커밋 전 변경까지 보므로 마지막 커밋을 보는 읽기 커넥션에서 만든다
+        auto writeLock = lockWriter();
+        ReadConnection read(dbHelper.inTransaction() ? connections : nullptr, dbHelper);
+        if (!balanceIndex.load(walletId, read.helper()) || !balanceIndex.balanceThrough(walletId, date, id, balance)) {
+            LOGE_REPO("Balance index unavailable for wallet ID %d.", walletId);
+            return false;
+        }
+        return true;
+    }
+
+    void TransactionRepository::setPageCacheBudget(size_t bytes) {
+        pageCache.setBudget(bytes);
+    }
+
+    PageCacheStats TransactionRepository::getPageCacheStats(bool reset) {
+        return pageCache.getStats(reset);
+    }
+
+    std::vector<MonthlyTotal> TransactionRepository::getMonthlyTotals(int walletId, int fromYyyymm, int toYyyymm) {
+        ScopedLatencyTimer timer(Operation::GET_MONTHLY_TOTALS);
+        std::vector<MonthlyTotal> totals;
+        ReadConnection read(connections, dbHelper);
+        DatabaseHelper& helper = read.helper();
+        sqlite3* db = helper.getDb();
+        if (!db) {
+            LOGE_REPO("Database not open for getMonthlyTotals.");
+            return totals;
+        }
+
+        sqlite3_stmt* stmt = helper.prepareCached(
+                "SELECT wallet_id, yyyymm, income, expense, count FROM MonthlyTotals "
+                "WHERE wallet_id = ? AND yyyymm BETWEEN ? AND ? ORDER BY yyyymm;");
+        if (!stmt) {
+            LOGE_REPO("SQL error (getMonthlyTotals prepare): %s", sqlite3_errmsg(db));
+            return totals;
+        }
+
+        sqlite3_bind_int(stmt, 1, walletId);
+        sqlite3_bind_int(stmt, 2, fromYyyymm > 0 ? fromYyyymm : INT_MIN);
+        sqlite3_bind_int(stmt, 3, toYyyymm > 0 ? toYyyymm : INT_MAX);
+
+        int rc;
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+            MonthlyTotal total;
+            total.walletId = sqlite3_column_int(stmt, 0);
+            total.yyyymm = sqlite3_column_int(stmt, 1);
+            total.income = sqlite3_column_int64(stmt, 2);
+            total.expense = sqlite3_column_int64(stmt, 3);
+            total.count = sqlite3_column_int64(stmt, 4);
+            totals.push_back(total);
+        }
+        if (rc != SQLITE_DONE) {
+            LOGE_REPO("SQL error (getMonthlyTotals step): %s", sqlite3_errmsg(db));
+        }
+
+        helper.releaseStatement(stmt);
+        LOGD_REPO("Retrieved %zu monthly totals for wallet ID %d.", totals.size(), walletId);
+        return totals;
+    }
+
+    bool TransactionRepository::rebuildMonthlyTotals() {
+        ScopedLatencyTimer timer(Operation::REBUILD_MONTHLY_TOTALS);
+        if (!dbHelper.getDb()) {
+            LOGE_REPO("Database not open for rebuildMonthlyTotals.");
+            return false;
+        }
+
+        auto writeLock = lockWriter();
+
+        sqlite3_int64 minId = 0;
+        sqlite3_int64 maxId = -1;
+        sqlite3_stmt* stmt = dbHelper.prepareCached("SELECT MIN(ID), MAX(ID) FROM Transactions;");
+        if (!stmt) {
+            LOGE_REPO("SQL error (rebuildMonthlyTotals prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
+            return false;
+        }
+        if (sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_type(stmt, 0) != SQLITE_NULL) {
+            minId = sqlite3_column_int64(stmt, 0);
+            maxId = sqlite3_column_int64(stmt, 1);
+        }
+        dbHelper.releaseStatement(stmt);
+
+        // 쓰기 잠금을 잡았고 열린 쓰기 트랜잭션이 없으면 모든 읽기 커넥션이 같은 마지막 커밋을 본다.
+        // 호출 측 트랜잭션 안이면 읽기 커넥션은 아직 커밋되지 않은 변경을 못 보므로 쓰기 커넥션에서 순서대로 집계한다.
+        int partitions = 1;
+        if (connections && connections->getReaderCount() > 1 && sqlite3_get_autocommit(dbHelper.getDb())) {
+            partitions = connections->getReaderCount();
+        }
+        sqlite3_int64 span = (maxId - minId) / partitions + 1;
+
+        std::vector<MonthlyTotalsAccumulator> partials(partitions);
+        std::vector<char> succeeded(partitions, 0);
+        auto aggregate = [&](int index, DatabaseHelper& helper) {
+            sqlite3_int64 first = minId + span * index;
+            sqlite3_int64 last = index == partitions - 1 ? maxId : first + span - 1;
+            succeeded[index] = accumulateMonthlyTotals(helper, first, last, partials[index]);
+        };
+
+        if (partitions == 1) {
+            aggregate(0, dbHelper);
+        } else {
+            std::vector<std::thread> workers;
+            workers.reserve(partitions);
+            for (int i = 0; i < partitions; ++i) {
+                workers.emplace_back([&, i] {
+                    ReadConnection read(connections, dbHelper);
+                    aggregate(i, read.helper());
+                });
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        MonthlyTotalsAccumulator totals;
+        for (int i = 0; i < partitions; ++i) {
+            if (!succeeded[i]) {
+                LOGE_REPO("rebuildMonthlyTotals: partition %d failed.", i);
+                return false;
+            }
+            totals.merge(partials[i]);
+        }
+
+        ScopedTransaction tx(dbHelper);
+        if (!tx.isActive()) {
+            LOGE_REPO("Failed to begin transaction for rebuildMonthlyTotals.");
+            return false;
+        }
+        if (!replaceMonthlyTotals(dbHelper, 0, totals)) {
+            return false;
+        }
+        if (!tx.commit()) {
+            LOGE_REPO("SQL error (rebuildMonthlyTotals commit): %s", sqlite3_errmsg(dbHelper.getDb()));
+            return false;
+        }
+        LOGD_REPO("MonthlyTotals rebuilt from IDs %lld..%lld in %d partitions.",
+                  static_cast<long long>(minId), static_cast<long long>(maxId), partitions);
+        return true;
+    }
+
+    bool TransactionRepository::verifyListQueryPlan() {
+        bool ok = dbHelper.queryUsesIndex(LIST_BY_WALLET_SQL, "idx_transactions_wallet_date") &&
+                  dbHelper.queryUsesIndex(NEXT_PAGE_SQL, "idx_transactions_wallet_date");
+        if (!ok) {
+            LOGE_REPO("Transaction list query does not use idx_transactions_wallet_date.");
+        }
+        return ok;
+    }
+
+    bool TransactionRepository::applyBalanceDelta(int walletId, long long delta) {
+        if (delta == 0) return true;
+
+        const char* sql = "UPDATE Wallets SET BALANCE = BALANCE + ? WHERE ID = ?;";
+        sqlite3_stmt *stmt = dbHelper.prepareCached(sql);
+        if (!stmt) {
+            LOGE_REPO("SQL error (applyBalanceDelta prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
+            return false;
+        }
+
+        sqlite3_bind_int64(stmt, 1, delta);
+        sqlite3_bind_int(stmt, 2, walletId);
+
+        int rc = sqlite3_step(stmt);
+        if (rc != SQLITE_DONE) {
+            LOGE_REPO("SQL error (applyBalanceDelta step): %s", sqlite3_errmsg(dbHelper.getDb()));
+            dbHelper.releaseStatement(stmt);
+            return false;
+        }
+
+        dbHelper.releaseStatement(stmt);
+        // 호출 측 트랜잭션이 롤백되면 DatabaseHelper 가 캐시를 비우므로 커밋을 기다리지 않고 반영한다
+        dbHelper.getWalletCache().addBalance(walletId, delta);
+        LOGD_REPO("Wallet ID %d balance adjusted by %lld.", walletId, delta);
+        return true;
+    }
+
+}
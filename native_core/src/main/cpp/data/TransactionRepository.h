@@ -5,27 +5,80 @@
 #ifndef POCKETMONEYAPP_TRANSACTIONREPOSITORY_H
 #define POCKETMONEYAPP_TRANSACTIONREPOSITORY_H
 
+#include <functional>
 #include <vector>
 #include "../domain/Transaction.h"
 #include "DatabaseHelper.h"
+#include "ConnectionManager.h"
+#include "MonthlyTotals.h"
+#include "BalanceIndex.h"
+#include "TransactionPageCache.h"
+#include "../platform/Log.h"
 
 #ifndef LOG_REPO_TAG
 #define LOG_REPO_TAG "TransactionRepo"
-#define LOGD_REPO(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_REPO_TAG, __VA_ARGS__)
-#define LOGE_REPO(...) __android_log_print(ANDROID_LOG_ERROR, LOG_REPO_TAG, __VA_ARGS__)
+#define LOGD_REPO(...) PLATFORM_LOGD(LOG_REPO_TAG, __VA_ARGS__)
+#define LOGE_REPO(...) PLATFORM_LOGE(LOG_REPO_TAG, __VA_ARGS__)
 #endif
 
 namespace data {
 
+    // 복사 없이 sqlite 컬럼 버퍼를 그대로 가리키는 행 뷰. 방문 콜백 안에서만 유효하다.
+    struct TransactionRowView {
+        int id;
+        int walletId;
+        long long amount;
+        int type;
+        int64_t transactionDate; // epoch 초
+        const char* description;
+        int descriptionBytes;
+    };
+
+    using TransactionRowVisitor = std::function<bool(const TransactionRowView&)>; // false 반환 시 중단
+
+    // 설명 검색 결과. 관련도(bm25, 작을수록 관련 높음), ID 순이며 다음 페이지는 (nextRank, nextId) 이후부터 조회한다.
+    struct TransactionSearchPage {
+        std::vector<domain::Transaction> transactions;
+        bool hasMore = false;
+        double nextRank = 0;
+        int nextId = 0;
+    };
+
     class TransactionRepository {
     private:
-        DatabaseHelper& dbHelper;
+        DatabaseHelper& dbHelper; // 쓰기 커넥션
+        ConnectionManager* connections; // 있으면 조회는 읽기 전용 커넥션에서 실행
+        BalanceIndex balanceIndex; // 시점별 잔액. 이 리포지토리를 거친 변경만 반영되므로 거래 쓰기는 모두 여기로 모은다
+        TransactionPageCache pageCache; // 목록 페이지. balanceIndex 와 같이 이 리포지토리의 변경으로만 무효화된다
+
+        // 거래 변경을 잔액 색인에 알린다. 변경한 트랜잭션 안(커밋 전)에서 부르며, 가장 바깥 트랜잭션이 커밋되어야 반영된다
+        void recordInserted(const domain::Transaction& transaction);
+        void recordRemoved(const domain::Transaction& transaction);
+        // 커밋된 거래 변경을 페이지 캐시에 반영한다
+        void onChanged(const domain::Transaction& transaction);
+
+        std::unique_lock<std::recursive_mutex> lockWriter();
+        domain::Transaction readTransactionById(DatabaseHelper& helper, int id);
+        // 스키마 버전 2 백필이 아직 옮기지 않은 행이면 먼저 Transactions 로 옮긴다 (호출 측 트랜잭션 안에서 실행)
+        bool promoteLegacyTransaction(int id);
+
+        // Wallets.BALANCE 에 증감분 반영 (호출 측 트랜잭션 안에서 실행)
+        bool applyBalanceDelta(int walletId, long long delta);
+
+        // (date, id) 까지의 잔액. 지갑 색인이 없으면 쓰기 잠금을 잡고 만든다
+        bool balanceThrough(int walletId, int64_t date, int id, long long& balance);
 
     public:
         explicit TransactionRepository(DatabaseHelper& helper);
+        explicit TransactionRepository(ConnectionManager& connections);
 
+        // 생성/수정/삭제는 행 변경과 지갑 잔액, MonthlyTotals 증감을 하나의 SQLite 트랜잭션으로 처리한다
         bool createTransaction(domain::Transaction& transaction);
 
+        // 전체를 하나의 BEGIN IMMEDIATE/COMMIT 으로 삽입하고 지갑별 잔액은 마지막에 한 번씩만 갱신한다.
+        // 하나라도 실패하면 전부 롤백한다. 성공 시 각 항목의 id 가 채워진다.
+        bool createTransactions(std::vector<domain::Transaction>& transactions);
+
         domain::Transaction getTransactionById(int id);
 
         std::vector<domain::Transaction> getTransactionsByWallet(int walletId, const std::string& orderBy = "transactionDate DESC");
@@ -35,6 +88,41 @@ namespace data {
         bool deleteTransaction(int id);
 
         std::vector<domain::Transaction> getTransactionsByWalletId(int walletId);
+
+        // (TransactionDate DESC, id DESC) 순서에서 커서 뒤의 limit 건. afterId 가 0 이하이면 첫 페이지.
+        // OFFSET 대신 인덱스 seek 를 사용하므로 깊은 페이지도 첫 페이지와 비용이 같다.
+        // withRunningBalances 이면 첫 행의 잔액만 색인에서 찾고 나머지는 금액을 거꾸로 빼서 채운다 (추가 쿼리 없음)
+        TransactionPage getTransactionsPage(int walletId, int64_t afterDate, int afterId, int limit,
+                                            bool withRunningBalances = false);
+
+        // getTransactionsPage 와 같은 범위를 도메인 객체 생성 없이 행 단위로 방문한다
+        bool scanTransactionsPage(int walletId, int64_t afterDate, int afterId, int limit,
+                                  const TransactionRowVisitor& visitor, bool& hasMore);
+
+        // Description 전문 검색 (TransactionsFts). 공백으로 나눈 단어마다 접두어 검색하고 모두 포함한 거래만 돌려준다.
+        // walletId 가 0 이면 모든 지갑, afterId 가 0 이하이면 첫 페이지. 마이그레이션 백필이 끝나기 전에는 옛 거래가 빠질 수 있다
+        TransactionSearchPage searchTransactions(const std::string& query, int walletId, int limit,
+                                                 double afterRank = 0, int afterId = 0);
+
+        // date 시점(포함)까지의 거래 합계 잔액. Fenwick 색인으로 O(log n) 이며
+        // 처음 조회하는 지갑만 거래를 한 번 읽는다. 거래가 없는 지갑은 0, 오류면 false.
+        // 읽기 커넥션과 같이 마지막 커밋 기준이며, 묶음 커밋 안의 변경은 바깥 트랜잭션이 커밋된 뒤에 보인다
+        bool balanceAt(int walletId, int64_t date, long long& balance);
+
+        // 지갑의 월별 수입/지출/건수 (yyyymm 오름차순). 기본키 범위 검색이라 거래 수와 무관하게 개월 수에 비례한다.
+        // fromYyyymm, toYyyymm 는 포함 범위이며 0 이면 제한 없음. 시작 백필이 끝나기 전에는 일부 달이 빠질 수 있다.
+        std::vector<MonthlyTotal> getMonthlyTotals(int walletId, int fromYyyymm = 0, int toYyyymm = 0);
+
+        // Transactions 전체에서 MonthlyTotals 를 다시 만든다. ID 범위를 읽기 커넥션 수만큼 나눠 병렬로 집계하고
+        // 결과를 한 트랜잭션으로 교체한다. 집계하는 동안 쓰기 잠금을 잡아 모든 조각이 같은 커밋 시점을 본다.
+        bool rebuildMonthlyTotals();
+
+        // getTransactionsPage / getTransactionsByWalletId 결과를 담아 두는 페이지 캐시 (기본 4 MiB)
+        void setPageCacheBudget(size_t bytes);
+        PageCacheStats getPageCacheStats(bool reset = false);
+
+        // 거래 목록 쿼리가 idx_transactions_wallet_date 를 타는지 EXPLAIN QUERY PLAN 으로 확인
+        bool verifyListQueryPlan();
     };
 
 }
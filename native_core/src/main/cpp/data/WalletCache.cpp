@@ -0,0 +1,178 @@
+//
+// Created by ss on 2025-08-12.
+//
+
+#include "WalletCache.h"
+#include "../platform/Log.h"
+
+#define LOG_TAG_DAL "NativeCoreDAL"
+#define LOGD_DAL(...) PLATFORM_LOGD(LOG_TAG_DAL, __VA_ARGS__)
+
+namespace data {
+
+    void WalletCache::bump() {
+        currentGeneration.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    void WalletCache::clearLocked() {
+        loaded = false;
+        slotOf.clear();
+        slots.clear();
+        freeSlots.clear();
+    }
+
+    bool WalletCache::putLocked(const domain::Wallet& wallet) {
+        if (wallet.id <= 0 || wallet.id > MAX_DENSE_ID) {
+            return false;
+        }
+        size_t id = static_cast<size_t>(wallet.id);
+        if (id >= slotOf.size()) {
+            slotOf.resize(id + 1, -1);
+        }
+        if (slotOf[id] >= 0) {
+            slots[static_cast<size_t>(slotOf[id])] = wallet;
+        } else if (!freeSlots.empty()) {
+            slotOf[id] = freeSlots.back();
+            freeSlots.pop_back();
+            slots[static_cast<size_t>(slotOf[id])] = wallet;
+        } else {
+            slotOf[id] = static_cast<int>(slots.size());
+            slots.push_back(wallet);
+        }
+        return true;
+    }
+
+    void WalletCache::disableLocked(int walletId) {
+        LOGD_DAL("[Info] Wallet cache disabled: wallet ID %d is out of range.", walletId);
+        clearLocked();
+        disabled = true;
+    }
+
+    void WalletCache::markLocked(int walletId) {
+        if (inTransaction) pending.insert(walletId);
+    }
+
+    bool WalletCache::isLoaded() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return loaded;
+    }
+
+    bool WalletCache::isDisabled() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return disabled || !enabled;
+    }
+
+    void WalletCache::setEnabled(bool value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        bump();
+        clearLocked();
+        enabled = value;
+    }
+
+    bool WalletCache::load(const std::vector<domain::Wallet>& wallets) {
+        std::lock_guard<std::mutex> lock(mutex);
+        clearLocked();
+        if (disabled || !enabled) return false;
+        slots.reserve(wallets.size());
+        for (const domain::Wallet& wallet : wallets) {
+            if (!putLocked(wallet)) {
+                disableLocked(wallet.id);
+                return false;
+            }
+        }
+        loaded = true;
+        LOGD_DAL("[Info] Wallet cache loaded %zu wallets.", slots.size());
+        return true;
+    }
+
+    bool WalletCache::get(int id, domain::Wallet& wallet) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!loaded || pending.count(id)) return false;
+        if (id > 0 && static_cast<size_t>(id) < slotOf.size() && slotOf[static_cast<size_t>(id)] >= 0) {
+            wallet = slots[static_cast<size_t>(slotOf[static_cast<size_t>(id)])];
+        } else {
+            wallet = domain::Wallet();
+        }
+        return true;
+    }
+
+    bool WalletCache::getAll(std::vector<domain::Wallet>& wallets) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!loaded || !pending.empty()) return false;
+        wallets.clear();
+        wallets.reserve(slots.size() - freeSlots.size());
+        for (int slot : slotOf) {
+            if (slot >= 0) wallets.push_back(slots[static_cast<size_t>(slot)]);
+        }
+        return true;
+    }
+
+    void WalletCache::put(const domain::Wallet& wallet) {
+        std::lock_guard<std::mutex> lock(mutex);
+        bump();
+        markLocked(wallet.id);
+        if (loaded && !putLocked(wallet)) {
+            disableLocked(wallet.id);
+        }
+    }
+
+    void WalletCache::remove(int id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        bump();
+        markLocked(id);
+        if (!loaded || id <= 0 || static_cast<size_t>(id) >= slotOf.size()) return;
+        int slot = slotOf[static_cast<size_t>(id)];
+        if (slot < 0) return;
+        slots[static_cast<size_t>(slot)] = domain::Wallet(); // 이름 문자열을 바로 놓아 준다
+        freeSlots.push_back(slot);
+        slotOf[static_cast<size_t>(id)] = -1;
+    }
+
+    void WalletCache::addBalance(int id, long long delta) {
+        std::lock_guard<std::mutex> lock(mutex);
+        bump();
+        markLocked(id);
+        if (!loaded || id <= 0 || static_cast<size_t>(id) >= slotOf.size()) return;
+        int slot = slotOf[static_cast<size_t>(id)];
+        if (slot >= 0) slots[static_cast<size_t>(slot)].balance += delta;
+    }
+
+    void WalletCache::setBalance(int id, long long balance) {
+        std::lock_guard<std::mutex> lock(mutex);
+        bump();
+        markLocked(id);
+        if (!loaded || id <= 0 || static_cast<size_t>(id) >= slotOf.size()) return;
+        int slot = slotOf[static_cast<size_t>(id)];
+        if (slot >= 0) slots[static_cast<size_t>(slot)].balance = balance;
+    }
+
+    void WalletCache::invalidate() {
+        std::lock_guard<std::mutex> lock(mutex);
+        bump();
+        clearLocked();
+        pending.clear();
+    }
+
+    void WalletCache::beginTransaction() {
+        std::lock_guard<std::mutex> lock(mutex);
+        inTransaction = true;
+    }
+
+    void WalletCache::endTransaction() {
+        std::lock_guard<std::mutex> lock(mutex);
+        inTransaction = false;
+        if (pending.empty()) return;
+        // 커밋된 값이 다시 조회되므로, 바뀔 때 세대를 보고 읽어 간 쪽이 한 번 더 읽게 한다
+        pending.clear();
+        bump();
+    }
+
+    uint64_t WalletCache::generation() const {
+        return currentGeneration.load(std::memory_order_acquire);
+    }
+
+    bool WalletCache::changedSince(uint64_t generation) const {
+        return currentGeneration.load(std::memory_order_acquire) != generation;
+    }
+
+}
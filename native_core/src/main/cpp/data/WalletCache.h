@@ -0,0 +1,74 @@
+//
+// Created by ss on 2025-08-12.
+//
+
+#ifndef POCKETMONEYAPP_WALLETCACHE_H
+#define POCKETMONEYAPP_WALLETCACHE_H
+
+#include "../domain/Wallet.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace data {
+
+    // Wallets 테이블 전체를 메모리에 들고 있는 write-through 캐시. 쓰기 커넥션의 DatabaseHelper 가 소유한다.
+    //  - WalletRepository 가 처음 조회할 때 쓰기 잠금 안에서 load 로 한 번 채운다.
+    //  - 지갑을 바꾸는 쪽(WalletRepository, TransactionRepository 의 잔액 증감)은 SQL 이 성공한 직후 같은 값을 반영한다.
+    //    SQL 로 Wallets 를 직접 고치는 코드는 invalidate() 를 불러 다음 조회에서 다시 읽게 한다.
+    //  - 바깥 트랜잭션 안에서 바뀐 지갑은 커밋될 때까지 조회에서 빠진다(get/getAll 이 false). 조회는 쓰기 잠금 없이
+    //    이루어지므로, 그동안은 읽기 커넥션이 마지막 커밋을 읽는다. DatabaseHelper 가 begin/endTransaction 을 부른다.
+    //  - 트랜잭션이 롤백되면 DatabaseHelper 가 invalidate() 한다.
+    // ID 는 AUTOINCREMENT 라 작고 촘촘하므로 id -> 슬롯 배열로 찾는다. MAX_DENSE_ID 를 넘는 ID 가 있으면 캐시를 쓰지 않는다.
+    // 모든 변경은 세대(generation)를 올리므로 UI 는 세대 비교만으로 다시 읽을지 정할 수 있다.
+    class WalletCache {
+    public:
+        static constexpr int MAX_DENSE_ID = 1 << 20;
+
+    private:
+        mutable std::mutex mutex;
+        bool loaded = false;
+        bool disabled = false;                // MAX_DENSE_ID 를 넘는 ID 를 본 뒤로는 다시 채우지 않는다
+        bool enabled = true;                  // setEnabled(false) 동안은 disabled 와 같이 동작한다
+        std::vector<int> slotOf;              // 지갑 ID -> slots 위치 (-1 이면 없음)
+        std::vector<domain::Wallet> slots;
+        std::vector<int> freeSlots;           // 지운 지갑이 쓰던 슬롯
+        bool inTransaction = false;           // 쓰기 커넥션에 바깥 트랜잭션이 열려 있다
+        std::unordered_set<int> pending;      // 그 트랜잭션에서 바뀐 지갑 ID (아직 커밋되지 않음)
+        std::atomic<uint64_t> currentGeneration{1};
+
+        void bump();
+        void clearLocked();
+        bool putLocked(const domain::Wallet& wallet); // MAX_DENSE_ID 를 넘으면 false
+        void disableLocked(int walletId);
+        void markLocked(int walletId); // 트랜잭션 안이면 커밋 전까지 조회에서 뺀다
+
+    public:
+        bool isLoaded() const;
+        bool isDisabled() const; // AUTOINCREMENT ID 는 줄지 않으므로 한 번 넘으면 계속 SQLite 에서 읽는다
+        void setEnabled(bool enabled); // 벤치마크 비교용. 끄면 비우고, 켜면 다음 조회에서 다시 채운다
+        bool load(const std::vector<domain::Wallet>& wallets); // ID 가 너무 크면 false (캐시는 비운 채로 둔다)
+
+        // 캐시가 비어 있거나 지갑이 커밋 전이면 false. 찾는 지갑이 없으면 true 와 함께 id 0 인 지갑을 돌려준다
+        bool get(int id, domain::Wallet& wallet) const;
+        bool getAll(std::vector<domain::Wallet>& wallets) const; // ID 오름차순. 커밋 전인 지갑이 하나라도 있으면 false
+
+        void put(const domain::Wallet& wallet); // 추가 또는 교체
+        void remove(int id);
+        void addBalance(int id, long long delta);
+        void setBalance(int id, long long balance);
+        void invalidate();
+
+        void beginTransaction(); // 바깥 BEGIN 직후
+        void endTransaction();   // 바깥 COMMIT/ROLLBACK 뒤 (롤백이면 invalidate() 다음에 부른다)
+
+        // 마지막 변경의 세대. 0 은 나오지 않으므로 "아직 읽은 적 없음" 으로 쓸 수 있다
+        uint64_t generation() const;
+        bool changedSince(uint64_t generation) const;
+    };
+
+}
+
+#endif //POCKETMONEYAPP_WALLETCACHE_H
@@ -3,86 +3,133 @@
 //
 
 #include "WalletRepository.h"
+#include "LatencyMetrics.h"
 #include <sstream>
-#include <android/log.h>
+#include "../platform/Log.h"
 
 #define LOG_TAG_REPO "NativeCoreRepo"
-#define LOGD_REPO(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG_REPO, __VA_ARGS__)
-#define LOGE_REPO(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG_REPO, __VA_ARGS__)
+#define LOGD_REPO(...) PLATFORM_LOGD(LOG_TAG_REPO, __VA_ARGS__)
+#define LOGE_REPO(...) PLATFORM_LOGE(LOG_TAG_REPO, __VA_ARGS__)
 
 namespace data {
 
-    WalletRepository::WalletRepository(DatabaseHelper& helper) : dbHelper(helper) {}
+    WalletRepository::WalletRepository(DatabaseHelper& helper) : dbHelper(helper), connections(nullptr) {}
+
+    WalletRepository::WalletRepository(ConnectionManager& connections)
+            : dbHelper(connections.writer()), connections(&connections) {}
+
+    std::unique_lock<std::recursive_mutex> WalletRepository::lockWriter() {
+        return connections ? connections->lockWriter() : std::unique_lock<std::recursive_mutex>();
+    }
 
     bool WalletRepository::createWallet(const domain::Wallet& wallet) {
+        ScopedLatencyTimer timer(Operation::CREATE_WALLET);
         if (!dbHelper.getDb()) {
             LOGE_REPO("Database not open for createWallet.");
             return false;
         }
 
-        std::stringstream ss;
-        ss << "INSERT INTO Wallets (NAME, DESCRIPTION, BALANCE) VALUES ('"
-           << wallet.name << "', '"
-           << wallet.description << "', "
-           << wallet.balance << ");";
-        std::string sql = ss.str();
+        auto writeLock = lockWriter();
 
-        char *zErrMsg = 0;
-        int rc = sqlite3_exec(dbHelper.getDb(), sql.c_str(), 0, 0, &zErrMsg);
-        if (rc != SQLITE_OK) {
-            LOGE_REPO("SQL error (createWallet): %s", zErrMsg);
-            sqlite3_free(zErrMsg);
+        // 문자열 조립 대신 바인딩을 사용해야 statement 를 캐시에서 재사용할 수 있다
+        const char* sql = "INSERT INTO Wallets (NAME, DESCRIPTION, BALANCE) VALUES (?, ?, ?);";
+        sqlite3_stmt *stmt = dbHelper.prepareCached(sql);
+        if (!stmt) {
+            LOGE_REPO("SQL error (createWallet prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
             return false;
         }
+
+        sqlite3_bind_text(stmt, 1, wallet.name.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, wallet.description.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(stmt, 3, wallet.balance);
+
+        int rc = sqlite3_step(stmt);
+        if (rc != SQLITE_DONE) {
+            LOGE_REPO("SQL error (createWallet): %s", sqlite3_errmsg(dbHelper.getDb()));
+            dbHelper.releaseStatement(stmt);
+            return false;
+        }
+        dbHelper.releaseStatement(stmt);
+        int id = static_cast<int>(sqlite3_last_insert_rowid(dbHelper.getDb()));
+        dbHelper.getWalletCache().put(domain::Wallet(id, wallet.name, wallet.description, wallet.balance));
         LOGD_REPO("Wallet created: %s", wallet.toString().c_str());
         return true;
     }
 
     std::vector<domain::Wallet> WalletRepository::getAllWallets() {
+        ScopedLatencyTimer timer(Operation::GET_ALL_WALLETS);
         std::vector<domain::Wallet> wallets;
 
-        if (!dbHelper.getDb()) {
-            LOGE_REPO("Database not open for getAllWallets.");
+        WalletCache& cache = dbHelper.getWalletCache();
+        if (cache.getAll(wallets) || (loadCache() && cache.getAll(wallets))) {
             return wallets;
         }
 
-        sqlite3_stmt *stmt;
+        ReadConnection read(connections, dbHelper);
+        readAllWallets(read.helper(), wallets);
+        LOGD_REPO("Retrieved %zu wallets.", wallets.size());
+        return wallets;
+    }
 
-        const char* sql = "SELECT ID, NAME, DESCRIPTION, BALANCE FROM Wallets;";
+    bool WalletRepository::readAllWallets(DatabaseHelper& helper, std::vector<domain::Wallet>& wallets) {
+        if (!helper.getDb()) {
+            LOGE_REPO("Database not open for getAllWallets.");
+            return false;
+        }
 
-        int rc = sqlite3_prepare_v2(dbHelper.getDb(), sql, -1, &stmt, 0);
-        if (rc != SQLITE_OK) {
-            LOGE_REPO("SQL error (getAllWallets prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
-            return wallets;
+        const char* sql = "SELECT ID, NAME, DESCRIPTION, BALANCE FROM Wallets ORDER BY ID;";
+
+        sqlite3_stmt *stmt = helper.prepareCached(sql);
+        if (!stmt) {
+            LOGE_REPO("SQL error (getAllWallets prepare): %s", sqlite3_errmsg(helper.getDb()));
+            return false;
         }
 
-        while (sqlite3_step(stmt) == SQLITE_ROW) {
+        int rc;
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
             domain::Wallet wallet;
 
             wallet.id = sqlite3_column_int(stmt, 0);
             wallet.name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-            wallet.description = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+            const unsigned char* description = sqlite3_column_text(stmt, 2);
+            wallet.description = description ? reinterpret_cast<const char*>(description) : "";
             wallet.balance = sqlite3_column_int64(stmt, 3);
 
             wallets.push_back(wallet);
         }
 
-        sqlite3_finalize(stmt);
+        helper.releaseStatement(stmt);
+        if (rc != SQLITE_DONE) {
+            LOGE_REPO("SQL error (getAllWallets step): %s", sqlite3_errmsg(helper.getDb()));
+            return false;
+        }
+        return true;
+    }
 
-        LOGD_REPO("Retrieved %zu wallets.", wallets.size());
-        return wallets;
+    bool WalletRepository::loadCache() {
+        WalletCache& cache = dbHelper.getWalletCache();
+        // 채워져 있는데 조회가 빠졌다면 커밋 전인 지갑이다: 쓰기 잠금(그룹 커밋 동안 잡혀 있다)을 기다리지 않는다
+        if (cache.isDisabled() || cache.isLoaded()) return false;
+
+        auto writeLock = lockWriter();
+        if (cache.isLoaded()) return true;
+        if (dbHelper.inTransaction()) return false; // 커밋 전 값으로 채우지 않는다
+        std::vector<domain::Wallet> wallets;
+        return readAllWallets(dbHelper, wallets) && cache.load(wallets);
     }
 
     bool WalletRepository::updateWallet(const domain::Wallet& wallet) {
+        ScopedLatencyTimer timer(Operation::UPDATE_WALLET);
         if (!dbHelper.getDb()) {
             LOGE_REPO("Database not open for updateWallet.");
             return false;
         }
 
-        sqlite3_stmt *stmt;
+        auto writeLock = lockWriter();
+
         const char* sql = "UPDATE Wallets SET NAME = ?, DESCRIPTION = ?, BALANCE = ? WHERE ID = ?;";
-        int rc = sqlite3_prepare_v2(dbHelper.getDb(), sql, -1, &stmt, 0);
-        if (rc != SQLITE_OK) {
+        sqlite3_stmt *stmt = dbHelper.prepareCached(sql);
+        if (!stmt) {
             LOGE_REPO("SQL error (updateWallet prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
             return false;
         }
@@ -93,28 +140,33 @@ namespace data {
         sqlite3_bind_int64(stmt, 3, wallet.balance);
         sqlite3_bind_int(stmt, 4, wallet.id);
 
-        rc = sqlite3_step(stmt);
+        int rc = sqlite3_step(stmt);
         if (rc != SQLITE_DONE) {
             LOGE_REPO("SQL error (updateWallet step): %s", sqlite3_errmsg(dbHelper.getDb()));
-            sqlite3_finalize(stmt);
+            dbHelper.releaseStatement(stmt);
             return false;
         }
 
-        sqlite3_finalize(stmt);
+        dbHelper.releaseStatement(stmt);
+        if (sqlite3_changes(dbHelper.getDb()) > 0) {
+            dbHelper.getWalletCache().put(wallet);
+        }
         LOGD_REPO("Wallet ID %d updated successfully.", wallet.id);
         return true;
     }
 
     bool WalletRepository::deleteWallet(int id) {
+        ScopedLatencyTimer timer(Operation::DELETE_WALLET);
         if (!dbHelper.getDb()) {
             LOGE_REPO("Database not open for deleteWallet.");
             return false;
         }
 
-        sqlite3_stmt *stmt;
+        auto writeLock = lockWriter();
+
         const char* sql = "DELETE FROM Wallets WHERE ID = ?;";
-        int rc = sqlite3_prepare_v2(dbHelper.getDb(), sql, -1, &stmt, 0);
-        if (rc != SQLITE_OK) {
+        sqlite3_stmt *stmt = dbHelper.prepareCached(sql);
+        if (!stmt) {
             LOGE_REPO("SQL error (deleteWallet prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
             return false;
         }
@@ -122,48 +174,63 @@ namespace data {
         // 바인딩: ?에 ID 값 바인딩
         sqlite3_bind_int(stmt, 1, id);
 
-        rc = sqlite3_step(stmt);
+        int rc = sqlite3_step(stmt);
         if (rc != SQLITE_DONE) {
             LOGE_REPO("SQL error (deleteWallet step): %s", sqlite3_errmsg(dbHelper.getDb()));
-            sqlite3_finalize(stmt);
+            dbHelper.releaseStatement(stmt);
             return false;
         }
 
-        sqlite3_finalize(stmt);
+        dbHelper.releaseStatement(stmt);
+        dbHelper.getWalletCache().remove(id);
         LOGD_REPO("Wallet ID %d deleted successfully.", id);
         return true;
     }
 
-    bool WalletRepository::recalculateBalance(int walletId) {
-        if (!dbHelper.getDb()) {
-            LOGE_REPO("Database not open for recalculateBalance.");
-            return false;
-        }
-
-        sqlite3_stmt *stmt;
+    bool WalletRepository::computeBalance(DatabaseHelper& helper, int walletId, long long& balance) {
         const char* sql =
                 "SELECT SUM(CASE WHEN Type = 0 THEN Amount ELSE -Amount END) FROM Transactions WHERE wallet_id = ?;";
-        int rc = sqlite3_prepare_v2(dbHelper.getDb(), sql, -1, &stmt, 0);
-        if (rc != SQLITE_OK) {
-            LOGE_REPO("SQL error (recalculateBalance prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
+        // 스키마 버전 2 백필 중에는 아직 옮겨지지 않은 거래가 Transactions_legacy 에 남아 있다
+        const char* sqlWithLegacy =
+                "SELECT SUM(CASE WHEN Type = 0 THEN Amount ELSE -Amount END) FROM ("
+                "SELECT Type, Amount FROM Transactions WHERE wallet_id = ?1 "
+                "UNION ALL SELECT Type, Amount FROM Transactions_legacy WHERE wallet_id = ?1);";
+        sqlite3_stmt *stmt = helper.prepareCached(helper.tableExists("Transactions_legacy") ? sqlWithLegacy : sql);
+        if (!stmt) {
+            LOGE_REPO("SQL error (computeBalance prepare): %s", sqlite3_errmsg(helper.getDb()));
             return false;
         }
 
         sqlite3_bind_int(stmt, 1, walletId);
 
-        long long newBalance = 0;
+        balance = 0;
         if (sqlite3_step(stmt) == SQLITE_ROW) {
             if (sqlite3_column_type(stmt, 0) != SQLITE_NULL) {
-                newBalance = sqlite3_column_int64(stmt, 0);
+                balance = sqlite3_column_int64(stmt, 0);
             }
         }
-        sqlite3_finalize(stmt);
+        helper.releaseStatement(stmt);
+        return true;
+    }
+
+    bool WalletRepository::recalculateBalance(int walletId) {
+        ScopedLatencyTimer timer(Operation::RECALCULATE_BALANCE);
+        if (!dbHelper.getDb()) {
+            LOGE_REPO("Database not open for recalculateBalance.");
+            return false;
+        }
+
+        auto writeLock = lockWriter();
+
+        long long newBalance = 0;
+        if (!computeBalance(dbHelper, walletId, newBalance)) {
+            return false;
+        }
         LOGD_REPO("Calculated new balance for wallet_id %d: %lld", walletId, newBalance);
 
-        sqlite3_stmt *updateStmt;
         const char* updateSql = "UPDATE Wallets SET BALANCE = ? WHERE ID = ?;";
-        rc = sqlite3_prepare_v2(dbHelper.getDb(), updateSql, -1, &updateStmt, 0);
-        if (rc != SQLITE_OK) {
+        sqlite3_stmt *updateStmt = dbHelper.prepareCached(updateSql);
+        if (!updateStmt) {
             LOGE_REPO("SQL error (recalculateBalance update prepare): %s", sqlite3_errmsg(dbHelper.getDb()));
             return false;
         }
@@ -171,29 +238,69 @@ namespace data {
         sqlite3_bind_int64(updateStmt, 1, newBalance);
         sqlite3_bind_int(updateStmt, 2, walletId);
 
-        rc = sqlite3_step(updateStmt);
+        int rc = sqlite3_step(updateStmt);
         if (rc != SQLITE_DONE) {
             LOGE_REPO("SQL error (recalculateBalance update step): %s", sqlite3_errmsg(dbHelper.getDb()));
-            sqlite3_finalize(updateStmt);
+            dbHelper.releaseStatement(updateStmt);
             return false;
         }
 
-        sqlite3_finalize(updateStmt);
+        dbHelper.releaseStatement(updateStmt);
+        dbHelper.getWalletCache().setBalance(walletId, newBalance);
         LOGD_REPO("Wallet ID %d balance updated to %lld successfully.", walletId, newBalance);
         return true;
     }
 
+    bool WalletRepository::verifyBalance(int walletId) {
+        ScopedLatencyTimer timer(Operation::VERIFY_BALANCE);
+        ReadConnection read(connections, dbHelper);
+        DatabaseHelper& helper = read.helper();
+
+        domain::Wallet wallet = readWalletById(helper, walletId);
+        if (wallet.id == 0) {
+            return false;
+        }
+
+        long long computed = 0;
+        if (!computeBalance(helper, walletId, computed)) {
+            return false;
+        }
+        if (computed != wallet.balance) {
+            LOGE_REPO("Wallet ID %d balance mismatch: stored %lld, computed %lld", walletId, wallet.balance, computed);
+            return false;
+        }
+        return true;
+    }
+
     domain::Wallet WalletRepository::getWalletById(int id) {
-        sqlite3* db = dbHelper.getDb();
+        ScopedLatencyTimer timer(Operation::GET_WALLET_BY_ID);
+        domain::Wallet wallet;
+        WalletCache& cache = dbHelper.getWalletCache();
+        if (cache.get(id, wallet) || (loadCache() && cache.get(id, wallet))) {
+            return wallet;
+        }
+        ReadConnection read(connections, dbHelper);
+        return readWalletById(read.helper(), id);
+    }
+
+    uint64_t WalletRepository::getGeneration() {
+        return dbHelper.getWalletCache().generation();
+    }
+
+    bool WalletRepository::hasChangedSince(uint64_t generation) {
+        return dbHelper.getWalletCache().changedSince(generation);
+    }
+
+    domain::Wallet WalletRepository::readWalletById(DatabaseHelper& helper, int id) {
+        sqlite3* db = helper.getDb();
         if (!db) {
             LOGE_REPO("Failed to get database connection for getting wallet by ID.");
             return domain::Wallet(); // 기본값 (ID 0)을 반환하여 찾지 못했음을 나타냄
         }
 
-        std::string sql = "SELECT id, name, description, balance FROM wallets WHERE id = ?;";
-        sqlite3_stmt* stmt;
-        int rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr);
-        if (rc != SQLITE_OK) {
+        const char* sql = "SELECT id, name, description, balance FROM wallets WHERE id = ?;";
+        sqlite3_stmt* stmt = helper.prepareCached(sql);
+        if (!stmt) {
             LOGE_REPO("Failed to prepare statement for get wallet by ID: %s", sqlite3_errmsg(db));
             return domain::Wallet();
         }
@@ -201,18 +308,19 @@ namespace data {
         sqlite3_bind_int(stmt, 1, id);
 
         domain::Wallet wallet;
-        if ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
             wallet.id = sqlite3_column_int(stmt, 0);
             wallet.name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-            wallet.description = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+            const unsigned char* description = sqlite3_column_text(stmt, 2);
+            wallet.description = description ? reinterpret_cast<const char*>(description) : "";
             wallet.balance = sqlite3_column_int64(stmt, 3);
             LOGD_REPO("getWalletById: Found wallet ID %d: %s", wallet.id, wallet.name.c_str());
         } else {
             LOGD_REPO("getWalletById: Wallet with ID %d not found.", id);
         }
 
-        sqlite3_finalize(stmt);
+        helper.releaseStatement(stmt);
         return wallet;
     }
 
-}
\ No newline at end of file
+}
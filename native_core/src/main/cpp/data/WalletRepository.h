@@ -7,6 +7,7 @@
 
 #include "../domain/Wallet.h"
 #include "DatabaseHelper.h"
+#include "ConnectionManager.h"
 #include <vector>
 #include <optional>
 
@@ -14,10 +15,22 @@ namespace data {
 
     class WalletRepository {
     private:
-        DatabaseHelper& dbHelper;
+        DatabaseHelper& dbHelper; // 쓰기 커넥션
+        ConnectionManager* connections; // 있으면 조회는 읽기 전용 커넥션에서 실행
+
+        std::unique_lock<std::recursive_mutex> lockWriter();
+        domain::Wallet readWalletById(DatabaseHelper& helper, int id);
+        bool readAllWallets(DatabaseHelper& helper, std::vector<domain::Wallet>& wallets);
+        // 지갑 캐시가 비어 있으면 쓰기 잠금 안에서 Wallets 전체를 읽어 채운다 (그 사이 커밋이 끼어들지 않게).
+        // 이미 채워져 있거나 쓰기 커넥션이 트랜잭션 안이면 false 이므로 호출한 쪽은 읽기 커넥션에서 읽는다
+        bool loadCache();
+        bool computeBalance(DatabaseHelper& helper, int walletId, long long& balance); // 전체 트랜잭션 SUM
 
     public:
+        // 조회는 쓰기 커넥션의 WalletCache 에서 SQLite 를 거치지 않고 답한다. 변경은 SQL 성공 직후 캐시에도 반영하되,
+        // 트랜잭션 안의 변경은 커밋될 때까지 캐시에서 빠지고 읽기 커넥션이 답한다
         explicit WalletRepository(DatabaseHelper& helper);
+        explicit WalletRepository(ConnectionManager& connections);
 
         bool createWallet(const domain::Wallet& wallet);
         domain::Wallet getWalletById(int id);
@@ -25,7 +38,14 @@ namespace data {
         bool updateWallet(const domain::Wallet& wallet);
         bool deleteWallet(int id);
 
+        // 잔액은 TransactionRepository 가 증감분으로 유지한다.
+        // 아래 두 함수는 전체 재계산이 필요한 복구/검증 용도로만 사용한다.
         bool recalculateBalance(int walletId);
+        bool verifyBalance(int walletId);
+
+        // 지갑(잔액 포함)이 바뀔 때마다 오르는 세대. 화면은 저장해 둔 세대와 비교해 다시 읽을지 정한다
+        uint64_t getGeneration();
+        bool hasChangedSince(uint64_t generation);
     };
 
 }
@@ -0,0 +1,187 @@
+//
+// Created by ss on 2025-08-06.
+//
+
+#include "WriteQueue.h"
+#include "../platform/Log.h"
+
+#define LOG_TAG_DAL "NativeCoreDAL"
+#define LOGD_DAL(...) PLATFORM_LOGD(LOG_TAG_DAL, __VA_ARGS__)
+#define LOGE_DAL(...) PLATFORM_LOGE(LOG_TAG_DAL, __VA_ARGS__)
+
+namespace data {
+
+    WriteQueue::WriteQueue(ConnectionManager* connections, const GroupCommitWindow& window)
+            : connections(connections), window(window), head(&stub), tail(&stub) {
+        worker = std::thread(&WriteQueue::run, this);
+    }
+
+    WriteQueue::~WriteQueue() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopRequested = true;
+        }
+        wakeUp.notify_one();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    std::future<bool> WriteQueue::submit(Task task) {
+        Node* node = new Node();
+        node->task = std::move(task);
+        std::future<bool> result = node->promise.get_future();
+        enqueue(node);
+        return result;
+    }
+
+    void WriteQueue::submit(Task task, Callback callback) {
+        Node* node = new Node();
+        node->task = std::move(task);
+        node->callback = std::move(callback);
+        enqueue(node);
+    }
+
+    bool WriteQueue::isWriterThread() const {
+        return std::this_thread::get_id() == worker.get_id();
+    }
+
+    const GroupCommitWindow& WriteQueue::getWindow() const {
+        return window;
+    }
+
+    void WriteQueue::enqueue(Node* node) {
+        push(node);
+        pending.fetch_add(1);
+        // pending 증가 후 sleeping 을 확인하므로 쓰기 스레드가 잠들기 직전이어도 깨어남을 놓치지 않는다
+        if (sleeping.load()) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            wakeUp.notify_one();
+        }
+    }
+
+    void WriteQueue::push(Node* node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    WriteQueue::Node* WriteQueue::pop() {
+        Node* current = tail;
+        Node* next = current->next.load(std::memory_order_acquire);
+        if (current == &stub) {
+            if (!next) return nullptr;
+            tail = next;
+            current = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            tail = next;
+            return current;
+        }
+        if (current != head.load(std::memory_order_acquire)) {
+            return nullptr; // 생산자가 연결하는 중. 잠시 후 다시 시도
+        }
+        push(&stub);
+        next = current->next.load(std::memory_order_acquire);
+        if (next) {
+            tail = next;
+            return current;
+        }
+        return nullptr;
+    }
+
+    WriteQueue::Node* WriteQueue::popUntil(std::chrono::steady_clock::time_point deadline) {
+        while (true) {
+            Node* node = pop();
+            if (node) {
+                pending.fetch_sub(1);
+                return node;
+            }
+            if (pending.load() > 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (std::chrono::steady_clock::now() >= deadline) return nullptr;
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            if (stopRequested) return nullptr;
+            sleeping = true;
+            bool arrived = wakeUp.wait_until(lock, deadline, [this] { return pending.load() > 0 || stopRequested.load(); });
+            sleeping = false;
+            if (!arrived || stopRequested) return nullptr;
+        }
+    }
+
+    void WriteQueue::complete(Node* node, bool success) {
+        if (node->callback) {
+            node->callback(success);
+        } else {
+            node->promise.set_value(success);
+        }
+        delete node;
+    }
+
+    void WriteQueue::runBatch(Node* first) {
+        std::vector<std::pair<Node*, bool>> done;
+        bool committed;
+        {
+            auto writerLock = connections->lockWriter();
+            DatabaseHelper& writer = connections->writer();
+            ScopedTransaction batch(writer);
+            bool grouped = batch.isActive();
+
+            auto deadline = std::chrono::steady_clock::now() + window.maxDelay;
+            Node* node = first;
+            while (node) {
+                bool success = false;
+                if (node->task) {
+                    // 작업별 SAVEPOINT. 실패한 작업만 되돌리고 같은 묶음의 나머지는 유지한다
+                    ScopedTransaction step(writer);
+                    success = step.isActive() && node->task() && step.commit();
+                }
+                done.emplace_back(node, success);
+                if (static_cast<int>(done.size()) >= window.maxOps) break;
+                node = popUntil(deadline);
+            }
+
+            // BEGIN 에 실패했다면 각 작업이 이미 자체 트랜잭션으로 커밋되었다
+            committed = grouped ? batch.commit() : true;
+            if (!committed) {
+                LOGE_DAL("[Error] Group commit of %zu operations failed.", done.size());
+            }
+        }
+        for (auto& entry : done) {
+            complete(entry.first, entry.second && committed);
+        }
+    }
+
+    void WriteQueue::run() {
+        LOGD_DAL("[Info] Writer thread started.");
+        while (true) {
+            Node* node = pop();
+            if (node) {
+                pending.fetch_sub(1);
+                if (connections) {
+                    runBatch(node);
+                } else {
+                    complete(node, node->task ? node->task() : false);
+                }
+                continue;
+            }
+
+            if (pending.load() > 0) {
+                std::this_thread::yield(); // push 가 끝나기를 기다린다
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            if (stopRequested) break;
+            sleeping = true;
+            wakeUp.wait(lock, [this] { return pending.load() > 0 || stopRequested.load(); });
+            sleeping = false;
+        }
+        LOGD_DAL("[Info] Writer thread stopped.");
+    }
+
+}
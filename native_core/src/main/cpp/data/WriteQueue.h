@@ -0,0 +1,84 @@
+//
+// Created by ss on 2025-08-06.
+//
+
+#ifndef POCKETMONEYAPP_WRITEQUEUE_H
+#define POCKETMONEYAPP_WRITEQUEUE_H
+
+#include "ConnectionManager.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace data {
+
+    // 그룹 커밋 창. 첫 작업 이후 maxDelay 안에 도착한 작업을 maxOps 개까지 한 트랜잭션으로 묶는다.
+    // JNI 호출자는 결과를 기다리며 막혀 있으므로 기본값은 기다리지 않고 이미 쌓인 작업만 묶는다.
+    struct GroupCommitWindow {
+        int maxOps = 64;
+        std::chrono::microseconds maxDelay{0};
+    };
+
+    // 모든 변경 작업을 하나의 네이티브 쓰기 스레드에서 제출 순서대로 실행한다.
+    // 생산자는 잠금 없는 MPSC 큐(Vyukov)에 넣기만 하고, 쓰기 스레드가 비어 있을 때만 조건 변수로 잠든다.
+    // 쓰기 커넥션을 한 스레드만 쓰므로 동시 쓰기끼리 SQLITE_BUSY 가 날 일이 없다.
+    // connections 가 주어지면 그룹 커밋을 한다. 작업마다 SAVEPOINT 로 감싸 실패는 해당 호출자에게만 돌아가고,
+    // 결과는 바깥 트랜잭션이 커밋된 뒤에 전달된다.
+    class WriteQueue {
+    public:
+        using Task = std::function<bool()>;
+        using Callback = std::function<void(bool)>;
+
+        explicit WriteQueue(ConnectionManager* connections = nullptr,
+                            const GroupCommitWindow& window = GroupCommitWindow());
+        ~WriteQueue(); // 남은 작업을 모두 실행한 뒤 스레드 종료
+
+        WriteQueue(const WriteQueue&) = delete;
+        WriteQueue& operator=(const WriteQueue&) = delete;
+
+        std::future<bool> submit(Task task);
+        void submit(Task task, Callback callback); // 콜백은 쓰기 스레드에서 호출된다
+
+        bool isWriterThread() const; // 쓰기 스레드 안에서 다시 submit().get() 하면 교착되므로 확인용
+        const GroupCommitWindow& getWindow() const;
+
+    private:
+        struct Node {
+            std::atomic<Node*> next{nullptr};
+            Task task;
+            Callback callback;
+            std::promise<bool> promise;
+        };
+
+        ConnectionManager* connections;
+        GroupCommitWindow window;
+
+        std::atomic<Node*> head; // 생산자가 교체
+        Node* tail;              // 쓰기 스레드만 접근
+        Node stub;
+
+        std::atomic<long> pending{0};
+        std::atomic<bool> sleeping{false};
+        std::atomic<bool> stopRequested{false};
+        std::mutex sleepMutex;
+        std::condition_variable wakeUp;
+        std::thread worker;
+
+        void push(Node* node);
+        Node* pop();
+        Node* popUntil(std::chrono::steady_clock::time_point deadline); // 마감까지 다음 작업을 기다린다
+        void enqueue(Node* node);
+        void complete(Node* node, bool success);
+        void runBatch(Node* first);
+        void run();
+    };
+
+}
+
+#endif //POCKETMONEYAPP_WRITEQUEUE_H
@@ -0,0 +1,106 @@
+//
+// Created by ss on 2025-08-04.
+//
+
+#include "DateTime.h"
+
+namespace domain {
+
+    namespace {
+
+        // 1970-01-01 기준 일 수 (proleptic Gregorian)
+        int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) {
+            y -= m <= 2;
+            const int64_t era = (y >= 0 ? y : y - 399) / 400;
+            const unsigned yoe = static_cast<unsigned>(y - era * 400);
+            const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+            const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+            return era * 146097 + static_cast<int64_t>(doe) - 719468;
+        }
+
+        void civilFromDays(int64_t z, int64_t& y, unsigned& m, unsigned& d) {
+            z += 719468;
+            const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+            const unsigned doe = static_cast<unsigned>(z - era * 146097);
+            const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+            const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+            const unsigned mp = (5 * doy + 2) / 153;
+            d = doy - (153 * mp + 2) / 5 + 1;
+            m = mp < 10 ? mp + 3 : mp - 9;
+            y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2);
+        }
+
+        bool readDigits(const char* p, int count, unsigned& value) {
+            value = 0;
+            for (int i = 0; i < count; ++i) {
+                unsigned digit = static_cast<unsigned>(p[i] - '0');
+                if (digit > 9) return false;
+                value = value * 10 + digit;
+            }
+            return true;
+        }
+
+        void writeDigits(char* p, int count, unsigned value) {
+            for (int i = count - 1; i >= 0; --i) {
+                p[i] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            }
+        }
+
+        constexpr int64_t SECONDS_PER_DAY = 86400;
+
+    }
+
+    bool parseDateTime(const char* text, size_t length, int64_t& epochSeconds) {
+        if (!text || length < DATE_TIME_LENGTH) return false;
+        if (text[4] != '-' || text[7] != '-' || text[10] != ' ' || text[13] != ':' || text[16] != ':') return false;
+
+        unsigned year, month, day, hour, minute, second;
+        if (!readDigits(text, 4, year) || !readDigits(text + 5, 2, month) || !readDigits(text + 8, 2, day) ||
+            !readDigits(text + 11, 2, hour) || !readDigits(text + 14, 2, minute) || !readDigits(text + 17, 2, second)) {
+            return false;
+        }
+        if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 59) return false;
+
+        epochSeconds = daysFromCivil(year, month, day) * SECONDS_PER_DAY + hour * 3600 + minute * 60 + second;
+        return true;
+    }
+
+    void formatDateTime(int64_t epochSeconds, char* out) {
+        int64_t days = epochSeconds / SECONDS_PER_DAY;
+        int64_t rem = epochSeconds % SECONDS_PER_DAY;
+        if (rem < 0) {
+            rem += SECONDS_PER_DAY;
+            --days;
+        }
+
+        int64_t year;
+        unsigned month, day;
+        civilFromDays(days, year, month, day);
+        unsigned secs = static_cast<unsigned>(rem);
+
+        writeDigits(out, 4, static_cast<unsigned>(year));
+        out[4] = '-';
+        writeDigits(out + 5, 2, month);
+        out[7] = '-';
+        writeDigits(out + 8, 2, day);
+        out[10] = ' ';
+        writeDigits(out + 11, 2, secs / 3600);
+        out[13] = ':';
+        writeDigits(out + 14, 2, secs / 60 % 60);
+        out[16] = ':';
+        writeDigits(out + 17, 2, secs % 60);
+        out[DATE_TIME_LENGTH] = '\0';
+    }
+
+    int yearMonth(int64_t epochSeconds) {
+        int64_t days = epochSeconds / SECONDS_PER_DAY;
+        if (epochSeconds % SECONDS_PER_DAY < 0) --days;
+
+        int64_t year;
+        unsigned month, day;
+        civilFromDays(days, year, month, day);
+        return static_cast<int>(year * 100 + month);
+    }
+
+}
@@ -0,0 +1,28 @@
+//
+// Created by ss on 2025-08-04.
+//
+
+#ifndef POCKETMONEYAPP_DATETIME_H
+#define POCKETMONEYAPP_DATETIME_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace domain {
+
+    // "YYYY-MM-DD HH:MM:SS" 형식 길이 (NUL 제외)
+    constexpr size_t DATE_TIME_LENGTH = 19;
+
+    // "YYYY-MM-DD HH:MM:SS" -> epoch 초. 타임존 변환 없이 벽시계 시각을 그대로 UTC 로 취급한다.
+    // 힙 할당 없이 동작하며 형식이 맞지 않으면 false.
+    bool parseDateTime(const char* text, size_t length, int64_t& epochSeconds);
+
+    // epoch 초 -> "YYYY-MM-DD HH:MM:SS". out 은 DATE_TIME_LENGTH + 1 바이트 이상이어야 한다.
+    void formatDateTime(int64_t epochSeconds, char* out);
+
+    // epoch 초 -> 연월 YYYYMM (예: 202508). 월별 집계 키로 쓴다
+    int yearMonth(int64_t epochSeconds);
+
+}
+
+#endif //POCKETMONEYAPP_DATETIME_H
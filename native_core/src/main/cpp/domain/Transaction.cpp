@@ -8,4 +8,8 @@
 
 namespace domain {
 
+    long long Transaction::signedAmount() const {
+        return type == TransactionType::INCOME ? amount : -amount;
+    }
+
 }
\ No newline at end of file
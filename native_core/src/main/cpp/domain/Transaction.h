@@ -7,6 +7,7 @@
 
 #include <string>
 #include <chrono>
+#include <cstdint>
 #include <ctime>
 
 namespace domain {
@@ -23,15 +24,18 @@ namespace domain {
         std::string description;
         long long amount;
         TransactionType type;
-        std::string transactionDate;
+        int64_t transactionDate; // epoch 초. 벽시계 시각을 그대로 UTC 로 취급 (문자열 변환은 DateTime.h)
 
-        Transaction() : id(0), walletId(0), description(""), amount(0), type(TransactionType::EXPENSE), transactionDate("") {}
+        Transaction() : id(0), walletId(0), description(""), amount(0), type(TransactionType::EXPENSE), transactionDate(0) {}
 
-        Transaction(int id, int walletId, const std::string& description, long long amount, TransactionType type, const std::string& transactionDate)
+        Transaction(int id, int walletId, const std::string& description, long long amount, TransactionType type, int64_t transactionDate)
                 : id(id), walletId(walletId), description(description), amount(amount), type(type), transactionDate(transactionDate) {}
 
-        Transaction(int walletId, const std::string& description, long long amount, TransactionType type, const std::string& transactionDate)
+        Transaction(int walletId, const std::string& description, long long amount, TransactionType type, int64_t transactionDate)
                 : id(0), walletId(walletId), description(description), amount(amount), type(type), transactionDate(transactionDate) {}
+
+        // 지갑 잔액에 반영되는 값 (수입 +, 지출 -)
+        long long signedAmount() const;
     };
 
 }
@@ -1,26 +1,53 @@
 #include <jni.h>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
 #include <string>
-#include <android/log.h>
+#include <thread>
+#include "platform/Log.h"
 #include "sqlite3.h"
 
 #include "data/DatabaseHelper.h"
+#include "data/ConnectionManager.h"
 #include "data/WalletRepository.h"
 #include "data/TransactionRepository.h"
+#include "data/ColumnarTransactionWriter.h"
+#include "data/CsvTransactionImporter.h"
+#include "data/TransactionExporter.h"
+#include "data/WriteQueue.h"
+#include "data/LatencyMetrics.h"
+#include "domain/DateTime.h"
 #include "domain/Wallet.h"
 #include "domain/Transaction.h"
 
 #define LOG_TAG "NativeCoreJNI"
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+#define LOGD(...) PLATFORM_LOGD(LOG_TAG, __VA_ARGS__)
+#define LOGE(...) PLATFORM_LOGE(LOG_TAG, __VA_ARGS__)
 
-static data::DatabaseHelper* s_dbHelper = nullptr;
+static data::ConnectionManager* s_connections = nullptr;
 static data::WalletRepository* s_walletRepo = nullptr;
 static data::TransactionRepository* s_transactionRepo = nullptr;
+static data::WriteQueue* s_writeQueue = nullptr;
+static std::mutex s_initMutex;
 
 jclass g_walletDtoClass = nullptr;
 jmethodID g_walletDtoConstructor = nullptr;
 jclass g_transactionDtoClass = nullptr;
 jmethodID g_transactionDtoConstructor = nullptr;
+jclass g_transactionPageDtoClass = nullptr;
+jmethodID g_transactionPageDtoConstructor = nullptr;
+jclass g_transactionSearchPageDtoClass = nullptr;
+jmethodID g_transactionSearchPageDtoConstructor = nullptr;
+jclass g_csvImportResultDtoClass = nullptr;
+jmethodID g_csvImportResultDtoConstructor = nullptr;
+jclass g_latencyStatDtoClass = nullptr;
+jmethodID g_latencyStatDtoConstructor = nullptr;
+jclass g_slowQueryDtoClass = nullptr;
+jmethodID g_slowQueryDtoConstructor = nullptr;
+jclass g_monthlyTotalDtoClass = nullptr;
+jmethodID g_monthlyTotalDtoConstructor = nullptr;
+jclass g_pageCacheStatsDtoClass = nullptr;
+jmethodID g_pageCacheStatsDtoConstructor = nullptr;
 
 JNIEXPORT jint JNI_OnLoad(JavaVM* vm, void* reserved) {
     JNIEnv* env;
@@ -63,6 +90,125 @@ JNIEXPORT jint JNI_OnLoad(JavaVM* vm, void* reserved) {
     }
     env->DeleteLocalRef(transactionDtoLocalClass);
 
+    jclass transactionPageDtoLocalClass = env->FindClass("com/example/pocketmoneyapp/data/TransactionPageDto");
+    if (transactionPageDtoLocalClass == nullptr) {
+        LOGE("JNI_OnLoad: Failed to find TransactionPageDto class");
+        return JNI_ERR;
+    }
+    g_transactionPageDtoClass = reinterpret_cast<jclass>(env->NewGlobalRef(transactionPageDtoLocalClass));
+    if (g_transactionPageDtoClass == nullptr) {
+        LOGE("JNI_OnLoad: Failed to create global ref for TransactionPageDto class");
+        return JNI_ERR;
+    }
+    g_transactionPageDtoConstructor = env->GetMethodID(g_transactionPageDtoClass, "<init>", "([Lcom/example/pocketmoneyapp/data/TransactionDto;ZLjava/lang/String;I[J)V");
+    if (g_transactionPageDtoConstructor == nullptr) {
+        LOGE("JNI_OnLoad: Failed to find TransactionPageDto constructor");
+        return JNI_ERR;
+    }
+    env->DeleteLocalRef(transactionPageDtoLocalClass);
+
+    jclass transactionSearchPageDtoLocalClass = env->FindClass("com/example/pocketmoneyapp/data/TransactionSearchPageDto");
+    if (transactionSearchPageDtoLocalClass == nullptr) {
+        LOGE("JNI_OnLoad: Failed to find TransactionSearchPageDto class");
+        return JNI_ERR;
+    }
+    g_transactionSearchPageDtoClass = reinterpret_cast<jclass>(env->NewGlobalRef(transactionSearchPageDtoLocalClass));
+    if (g_transactionSearchPageDtoClass == nullptr) {
+        LOGE("JNI_OnLoad: Failed to create global ref for TransactionSearchPageDto class");
+        return JNI_ERR;
+    }
+    g_transactionSearchPageDtoConstructor = env->GetMethodID(g_transactionSearchPageDtoClass, "<init>", "([Lcom/example/pocketmoneyapp/data/TransactionDto;ZDI)V");
+    if (g_transactionSearchPageDtoConstructor == nullptr) {
+        LOGE("JNI_OnLoad: Failed to find TransactionSearchPageDto constructor");
+        return JNI_ERR;
+    }
+    env->DeleteLocalRef(transactionSearchPageDtoLocalClass);
+
+    jclass csvImportResultDtoLocalClass = env->FindClass("com/example/pocketmoneyapp/data/CsvImportResultDto");
+    if (csvImportResultDtoLocalClass == nullptr) {
+        LOGE("JNI_OnLoad: Failed to find CsvImportResultDto class");
+        return JNI_ERR;
+    }
+    g_csvImportResultDtoClass = reinterpret_cast<jclass>(env->NewGlobalRef(csvImportResultDtoLocalClass));
+    if (g_csvImportResultDtoClass == nullptr) {
+        LOGE("JNI_OnLoad: Failed to create global ref for CsvImportResultDto class");
+        return JNI_ERR;
+    }
+    g_csvImportResultDtoConstructor = env->GetMethodID(g_csvImportResultDtoClass, "<init>", "(ZZJJJ)V");
+    if (g_csvImportResultDtoConstructor == nullptr) {
+        LOGE("JNI_OnLoad: Failed to find CsvImportResultDto constructor");
+        return JNI_ERR;
+    }
+    env->DeleteLocalRef(csvImportResultDtoLocalClass);
+
+    jclass latencyStatDtoLocalClass = env->FindClass("com/example/pocketmoneyapp/data/LatencyStatDto");
+    if (latencyStatDtoLocalClass == nullptr) {
+        LOGE("JNI_OnLoad: Failed to find LatencyStatDto class");
+        return JNI_ERR;
+    }
+    g_latencyStatDtoClass = reinterpret_cast<jclass>(env->NewGlobalRef(latencyStatDtoLocalClass));
+    if (g_latencyStatDtoClass == nullptr) {
+        LOGE("JNI_OnLoad: Failed to create global ref for LatencyStatDto class");
+        return JNI_ERR;
+    }
+    g_latencyStatDtoConstructor = env->GetMethodID(g_latencyStatDtoClass, "<init>", "(Ljava/lang/String;JJJJJ)V");
+    if (g_latencyStatDtoConstructor == nullptr) {
+        LOGE("JNI_OnLoad: Failed to find LatencyStatDto constructor");
+        return JNI_ERR;
+    }
+    env->DeleteLocalRef(latencyStatDtoLocalClass);
+
+    jclass slowQueryDtoLocalClass = env->FindClass("com/example/pocketmoneyapp/data/SlowQueryDto");
+    if (slowQueryDtoLocalClass == nullptr) {
+        LOGE("JNI_OnLoad: Failed to find SlowQueryDto class");
+        return JNI_ERR;
+    }
+    g_slowQueryDtoClass = reinterpret_cast<jclass>(env->NewGlobalRef(slowQueryDtoLocalClass));
+    if (g_slowQueryDtoClass == nullptr) {
+        LOGE("JNI_OnLoad: Failed to create global ref for SlowQueryDto class");
+        return JNI_ERR;
+    }
+    g_slowQueryDtoConstructor = env->GetMethodID(g_slowQueryDtoClass, "<init>", "(Ljava/lang/String;JJIII)V");
+    if (g_slowQueryDtoConstructor == nullptr) {
+        LOGE("JNI_OnLoad: Failed to find SlowQueryDto constructor");
+        return JNI_ERR;
+    }
+    env->DeleteLocalRef(slowQueryDtoLocalClass);
+
+    jclass monthlyTotalDtoLocalClass = env->FindClass("com/example/pocketmoneyapp/data/MonthlyTotalDto");
+    if (monthlyTotalDtoLocalClass == nullptr) {
+        LOGE("JNI_OnLoad: Failed to find MonthlyTotalDto class");
+        return JNI_ERR;
+    }
+    g_monthlyTotalDtoClass = reinterpret_cast<jclass>(env->NewGlobalRef(monthlyTotalDtoLocalClass));
+    if (g_monthlyTotalDtoClass == nullptr) {
+        LOGE("JNI_OnLoad: Failed to create global ref for MonthlyTotalDto class");
+        return JNI_ERR;
+    }
+    g_monthlyTotalDtoConstructor = env->GetMethodID(g_monthlyTotalDtoClass, "<init>", "(IIJJI)V");
+    if (g_monthlyTotalDtoConstructor == nullptr) {
+        LOGE("JNI_OnLoad: Failed to find MonthlyTotalDto constructor");
+        return JNI_ERR;
+    }
+    env->DeleteLocalRef(monthlyTotalDtoLocalClass);
+
+    jclass pageCacheStatsDtoLocalClass = env->FindClass("com/example/pocketmoneyapp/data/PageCacheStatsDto");
+    if (pageCacheStatsDtoLocalClass == nullptr) {
+        LOGE("JNI_OnLoad: Failed to find PageCacheStatsDto class");
+        return JNI_ERR;
+    }
+    g_pageCacheStatsDtoClass = reinterpret_cast<jclass>(env->NewGlobalRef(pageCacheStatsDtoLocalClass));
+    if (g_pageCacheStatsDtoClass == nullptr) {
+        LOGE("JNI_OnLoad: Failed to create global ref for PageCacheStatsDto class");
+        return JNI_ERR;
+    }
+    g_pageCacheStatsDtoConstructor = env->GetMethodID(g_pageCacheStatsDtoClass, "<init>", "(JJJJJIJ)V");
+    if (g_pageCacheStatsDtoConstructor == nullptr) {
+        LOGE("JNI_OnLoad: Failed to find PageCacheStatsDto constructor");
+        return JNI_ERR;
+    }
+    env->DeleteLocalRef(pageCacheStatsDtoLocalClass);
+
     LOGD("JNI_OnLoad: Classes and constructors loaded successfully.");
     return JNI_VERSION_1_6;
 }
@@ -81,9 +227,116 @@ JNIEXPORT void JNI_OnUnload(JavaVM* vm, void* reserved) {
         env->DeleteGlobalRef(g_transactionDtoClass);
         g_transactionDtoClass = nullptr;
     }
+    if (g_transactionSearchPageDtoClass != nullptr) {
+        env->DeleteGlobalRef(g_transactionSearchPageDtoClass);
+        g_transactionSearchPageDtoClass = nullptr;
+    }
+    if (g_csvImportResultDtoClass != nullptr) {
+        env->DeleteGlobalRef(g_csvImportResultDtoClass);
+        g_csvImportResultDtoClass = nullptr;
+    }
+    if (g_transactionPageDtoClass != nullptr) {
+        env->DeleteGlobalRef(g_transactionPageDtoClass);
+        g_transactionPageDtoClass = nullptr;
+    }
+    if (g_monthlyTotalDtoClass != nullptr) {
+        env->DeleteGlobalRef(g_monthlyTotalDtoClass);
+        g_monthlyTotalDtoClass = nullptr;
+    }
+    if (g_pageCacheStatsDtoClass != nullptr) {
+        env->DeleteGlobalRef(g_pageCacheStatsDtoClass);
+        g_pageCacheStatsDtoClass = nullptr;
+    }
+    if (g_latencyStatDtoClass != nullptr) {
+        env->DeleteGlobalRef(g_latencyStatDtoClass);
+        g_latencyStatDtoClass = nullptr;
+    }
+    if (g_slowQueryDtoClass != nullptr) {
+        env->DeleteGlobalRef(g_slowQueryDtoClass);
+        g_slowQueryDtoClass = nullptr;
+    }
     LOGD("JNI_OnUnload: Global references released.");
 }
 
+// 변경 작업은 모두 쓰기 스레드에서 제출 순서대로 실행하고, JNI 호출자는 결과를 기다린다
+static bool runOnWriter(const data::WriteQueue::Task& task) {
+    if (s_writeQueue == nullptr || s_writeQueue->isWriterThread()) {
+        return task();
+    }
+    return s_writeQueue->submit(task).get();
+}
+
+// "YYYY-MM-DD HH:MM:SS" jstring -> epoch 초. GetStringUTFChars 복사 없이 스택 버퍼로 읽는다
+static bool readDateTime(JNIEnv* env, jstring dateJString, int64_t& epochSeconds) {
+    if (dateJString == nullptr || env->GetStringLength(dateJString) != static_cast<jsize>(domain::DATE_TIME_LENGTH)) {
+        return false;
+    }
+    char buffer[domain::DATE_TIME_LENGTH * 3 + 1]; // 수정 UTF-8 은 UTF-16 한 단위당 최대 3바이트
+    env->GetStringUTFRegion(dateJString, 0, static_cast<jsize>(domain::DATE_TIME_LENGTH), buffer);
+    return domain::parseDateTime(buffer, domain::DATE_TIME_LENGTH, epochSeconds);
+}
+
+static jstring newDateTimeString(JNIEnv* env, int64_t epochSeconds) {
+    char buffer[domain::DATE_TIME_LENGTH + 1];
+    domain::formatDateTime(epochSeconds, buffer);
+    return env->NewStringUTF(buffer);
+}
+
+static jobjectArray newTransactionDtoArray(JNIEnv* env, const std::vector<domain::Transaction>& transactions) {
+    jclass transactionDtoClass = g_transactionDtoClass;
+    if (transactionDtoClass == nullptr) {
+        LOGE("Failed to get global ref for TransactionDto class.");
+        return nullptr;
+    }
+    jmethodID constructor = g_transactionDtoConstructor;
+    if (constructor == nullptr) {
+        LOGE("Failed to get global ref for TransactionDto constructor.");
+        return nullptr;
+    }
+
+    jobjectArray transactionArray = env->NewObjectArray(transactions.size(), transactionDtoClass, nullptr);
+    if (transactionArray == nullptr) {
+        LOGE("Failed to create new jobjectArray for transactions.");
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        jstring descriptionJStr = env->NewStringUTF(transactions[i].description.c_str());
+        jstring transactionDateJStr = newDateTimeString(env, transactions[i].transactionDate);
+
+        jobject transactionDtoObj = env->NewObject(transactionDtoClass, constructor,
+                                                   static_cast<jint>(transactions[i].id),
+                                                   static_cast<jint>(transactions[i].walletId),
+                                                   static_cast<jlong>(transactions[i].amount),
+                                                   descriptionJStr,
+                                                   static_cast<jint>(transactions[i].type),
+                                                   transactionDateJStr);
+        env->SetObjectArrayElement(transactionArray, i, transactionDtoObj);
+
+        env->DeleteLocalRef(descriptionJStr);
+        env->DeleteLocalRef(transactionDateJStr);
+        env->DeleteLocalRef(transactionDtoObj);
+    }
+    return transactionArray;
+}
+
+// 시작 예산 안에 끝나지 않은 백필은 쓰기 스레드에서 조각씩 이어간다.
+// 조각이 끝날 때마다 큐 뒤에 다시 넣으므로 그 사이 들어온 변경이 오래 기다리지 않는다.
+static void continueMigrationsInBackground() {
+    static const std::chrono::milliseconds slice(50);
+    s_writeQueue->submit([] {
+        return s_connections->continueMigrations(slice) != data::MigrationStatus::FAILED;
+    }, [](bool success) {
+        if (!success) {
+            LOGE("Background schema backfill failed.");
+        } else if (s_connections->hasPendingMigrations()) {
+            continueMigrationsInBackground();
+        } else {
+            LOGD("Background schema backfill finished.");
+        }
+    });
+}
+
 extern "C" JNIEXPORT void JNICALL
 Java_com_example_pocketmoneyapp_MainActivity_initializeNativeDb(
         JNIEnv* env,
@@ -94,23 +347,39 @@ Java_com_example_pocketmoneyapp_MainActivity_initializeNativeDb(
     std::string dbPath = dbPathCStr;
     env->ReleaseStringUTFChars(dbPathJString, dbPathCStr);
 
-    if (s_dbHelper == nullptr) {
-        s_dbHelper = new data::DatabaseHelper(dbPath);
-        if (!s_dbHelper->openDatabase()) {
+    std::lock_guard<std::mutex> lock(s_initMutex);
+    if (s_connections == nullptr) {
+        // 쓰기 1개 + 읽기 전용 N개. 읽기는 코어 수에 맞춰 병렬로 처리된다.
+        unsigned cores = std::thread::hardware_concurrency();
+        int readerCount = cores >= 8 ? 4 : (cores >= 4 ? 2 : 1);
+        s_connections = new data::ConnectionManager(dbPath, readerCount);
+        if (!s_connections->open()) {
             LOGE("Failed to open database at %s", dbPath.c_str());
+            delete s_connections;
+            s_connections = nullptr;
             return;
         }
-        if (!s_dbHelper->createTables()) {
-            LOGE("Failed to create tables in database.");
-            return;
-        }
-        LOGD("Database initialized and tables created successfully.");
+        LOGD("Database initialized and tables created successfully (%d read connections).", s_connections->getReaderCount());
 
-        s_walletRepo = new data::WalletRepository(*s_dbHelper);
+        s_walletRepo = new data::WalletRepository(*s_connections);
         LOGD("WalletRepository created.");
 
-        s_transactionRepo = new data::TransactionRepository(*s_dbHelper);
+        s_transactionRepo = new data::TransactionRepository(*s_connections);
         LOGD("TransactionRepository created.");
+
+        // 동시에 대기 중인 변경은 최대 64개까지 한 트랜잭션에 묶어 커밋한다
+        s_writeQueue = new data::WriteQueue(s_connections, data::GroupCommitWindow());
+        LOGD("Writer queue started (group commit: %d ops / %lld us).",
+             s_writeQueue->getWindow().maxOps,
+             static_cast<long long>(s_writeQueue->getWindow().maxDelay.count()));
+
+        if (s_connections->hasPendingMigrations()) {
+            continueMigrationsInBackground();
+        }
+
+        if (!s_transactionRepo->verifyListQueryPlan()) {
+            LOGE("Transaction list query plan check failed; list loads will fall back to a full scan.");
+        }
     } else {
         LOGD("Database already initialized.");
     }
@@ -135,7 +404,7 @@ Java_com_example_pocketmoneyapp_MainActivity_createWalletNative(
     env->ReleaseStringUTFChars(nameJString, nameCStr);
     env->ReleaseStringUTFChars(descriptionJString, descriptionCStr);
 
-    bool success = s_walletRepo->createWallet(newWallet);
+    bool success = runOnWriter([&] { return s_walletRepo->createWallet(newWallet); });
     LOGD("createWalletNative: Created wallet: %s, success: %d", newWallet.name.c_str(), success);
     return success ? JNI_TRUE : JNI_FALSE;
 }
@@ -249,7 +518,7 @@ Java_com_example_pocketmoneyapp_MainActivity_updateWalletNative(
     env->ReleaseStringUTFChars(nameJString, nameCStr);
     env->ReleaseStringUTFChars(descriptionJString, descriptionCStr);
 
-    bool success = s_walletRepo->updateWallet(wallet);
+    bool success = runOnWriter([&] { return s_walletRepo->updateWallet(wallet); });
     LOGD("updateWalletNative: Updated wallet ID %d, success: %d", wallet.id, success);
     return success ? JNI_TRUE : JNI_FALSE;
 }
@@ -262,7 +531,7 @@ Java_com_example_pocketmoneyapp_MainActivity_deleteWalletNative(
         return JNI_FALSE;
     }
 
-    bool success = s_walletRepo->deleteWallet(static_cast<int>(id));
+    bool success = runOnWriter([&] { return s_walletRepo->deleteWallet(static_cast<int>(id)); });
     LOGD("deleteWalletNative: Deleted wallet ID %d, success: %d", static_cast<int>(id), success);
     return success ? JNI_TRUE : JNI_FALSE;
 }
@@ -276,29 +545,186 @@ Java_com_example_pocketmoneyapp_TransactionListActivity_createTransactionNative(
         return JNI_FALSE;
     }
 
+    domain::Transaction newTransaction;
+    if (!readDateTime(env, transactionDateJString, newTransaction.transactionDate)) {
+        LOGE("createTransactionNative: Invalid transaction date.");
+        return JNI_FALSE;
+    }
+
     const char* descriptionCStr = env->GetStringUTFChars(descriptionJString, nullptr);
-    const char* transactionDateCStr = env->GetStringUTFChars(transactionDateJString, nullptr);
 
-    domain::Transaction newTransaction;
     newTransaction.walletId = static_cast<int>(walletId);
     newTransaction.description = descriptionCStr;
     newTransaction.amount = static_cast<long long>(amount);
     newTransaction.type = static_cast<domain::TransactionType>(type);
-    newTransaction.transactionDate = transactionDateCStr;
 
     env->ReleaseStringUTFChars(descriptionJString, descriptionCStr);
-    env->ReleaseStringUTFChars(transactionDateJString, transactionDateCStr);
 
-    bool success = s_transactionRepo->createTransaction(newTransaction);
+    // 잔액은 같은 SQLite 트랜잭션 안에서 증감분으로 갱신된다
+    bool success = runOnWriter([&] { return s_transactionRepo->createTransaction(newTransaction); });
     LOGD("createTransactionNative: Created transaction for wallet ID %d, success: %d", newTransaction.walletId, success);
 
-    if (success && s_walletRepo != nullptr) {
-        s_walletRepo->recalculateBalance(newTransaction.walletId);
-        LOGD("createTransactionNative: Recalculated balance for wallet ID %d", newTransaction.walletId);
-    }
     return success ? JNI_TRUE : JNI_FALSE;
 }
 
+extern "C" JNIEXPORT jint JNICALL
+Java_com_example_pocketmoneyapp_TransactionListActivity_createTransactionsNative(
+        JNIEnv* env, jobject /* this */, jintArray walletIdsArray, jobjectArray descriptionsArray,
+        jlongArray amountsArray, jintArray typesArray, jobjectArray transactionDatesArray) {
+
+    if (s_transactionRepo == nullptr) {
+        LOGE("TransactionRepository not initialized. Call initializeNativeDb first.");
+        return 0;
+    }
+
+    jsize count = env->GetArrayLength(walletIdsArray);
+    if (env->GetArrayLength(descriptionsArray) != count || env->GetArrayLength(amountsArray) != count ||
+        env->GetArrayLength(typesArray) != count || env->GetArrayLength(transactionDatesArray) != count) {
+        LOGE("createTransactionsNative: Array lengths do not match.");
+        return 0;
+    }
+
+    std::vector<domain::Transaction> transactions(static_cast<size_t>(count));
+
+    jint* walletIds = env->GetIntArrayElements(walletIdsArray, nullptr);
+    jlong* amounts = env->GetLongArrayElements(amountsArray, nullptr);
+    jint* types = env->GetIntArrayElements(typesArray, nullptr);
+    for (jsize i = 0; i < count; ++i) {
+        transactions[i].walletId = static_cast<int>(walletIds[i]);
+        transactions[i].amount = static_cast<long long>(amounts[i]);
+        transactions[i].type = static_cast<domain::TransactionType>(types[i]);
+    }
+    env->ReleaseIntArrayElements(walletIdsArray, walletIds, JNI_ABORT);
+    env->ReleaseLongArrayElements(amountsArray, amounts, JNI_ABORT);
+    env->ReleaseIntArrayElements(typesArray, types, JNI_ABORT);
+
+    for (jsize i = 0; i < count; ++i) {
+        auto descriptionJString = static_cast<jstring>(env->GetObjectArrayElement(descriptionsArray, i));
+        auto transactionDateJString = static_cast<jstring>(env->GetObjectArrayElement(transactionDatesArray, i));
+        if (descriptionJString == nullptr || transactionDateJString == nullptr) {
+            LOGE("createTransactionsNative: Null string at index %d.", static_cast<int>(i));
+            return 0;
+        }
+
+        bool validDate = readDateTime(env, transactionDateJString, transactions[i].transactionDate);
+        env->DeleteLocalRef(transactionDateJString);
+        if (!validDate) {
+            LOGE("createTransactionsNative: Invalid transaction date at index %d.", static_cast<int>(i));
+            env->DeleteLocalRef(descriptionJString);
+            return 0;
+        }
+
+        const char* descriptionCStr = env->GetStringUTFChars(descriptionJString, nullptr);
+        transactions[i].description = descriptionCStr;
+        env->ReleaseStringUTFChars(descriptionJString, descriptionCStr);
+
+        env->DeleteLocalRef(descriptionJString);
+    }
+
+    bool success = runOnWriter([&] { return s_transactionRepo->createTransactions(transactions); });
+    LOGD("createTransactionsNative: Imported %d transactions, success: %d", static_cast<int>(count), success);
+    return success ? count : 0;
+}
+
+extern "C" JNIEXPORT jobject JNICALL
+Java_com_example_pocketmoneyapp_TransactionListActivity_importTransactionsCsvNative(
+        JNIEnv* env, jobject /* this */, jint fd, jint walletId, jobject listener) {
+
+    if (s_connections == nullptr || s_transactionRepo == nullptr) {
+        LOGE("TransactionRepository not initialized. Call initializeNativeDb first.");
+        return nullptr;
+    }
+    if (g_csvImportResultDtoClass == nullptr || g_csvImportResultDtoConstructor == nullptr) {
+        LOGE("Failed to get global ref for CsvImportResultDto in importTransactionsCsvNative.");
+        return nullptr;
+    }
+
+    // 리스너 구현 클래스가 호출마다 다를 수 있으므로 메서드는 여기서 찾는다. 콜백은 이 호출 스레드에서만 불린다
+    jmethodID onProgress = nullptr;
+    if (listener != nullptr) {
+        jclass listenerClass = env->GetObjectClass(listener);
+        onProgress = env->GetMethodID(listenerClass, "onProgress", "(JJJJ)Z");
+        env->DeleteLocalRef(listenerClass);
+        if (onProgress == nullptr) {
+            LOGE("importTransactionsCsvNative: listener has no onProgress(JJJJ)Z.");
+            return nullptr;
+        }
+    }
+    data::CsvImportProgressCallback progress = [&](const data::CsvImportProgress& p) {
+        if (onProgress == nullptr) return true;
+        if (env->ExceptionCheck()) return false; // 리스너가 던진 예외는 취소로 보고 Java 로 그대로 전달한다
+        jboolean keepGoing = env->CallBooleanMethod(listener, onProgress,
+                                                    static_cast<jlong>(p.bytesRead), static_cast<jlong>(p.totalBytes),
+                                                    static_cast<jlong>(p.rowsCommitted), static_cast<jlong>(p.rowsRejected));
+        return !env->ExceptionCheck() && keepGoing == JNI_TRUE;
+    };
+
+    data::CsvImportOptions options;
+    options.walletId = static_cast<int>(walletId);
+    // 쓰기 스레드를 거치지 않고 자체 삽입 스레드가 커밋 단위로 쓰기 잠금을 잡는다. 그 사이 UI 쓰기가 끼어든다
+    data::CsvTransactionImporter importer(*s_connections, *s_transactionRepo, options);
+    data::CsvImportResult result = importer.importFd(static_cast<int>(fd), progress);
+    if (env->ExceptionCheck()) {
+        return nullptr;
+    }
+
+    LOGD("importTransactionsCsvNative: Imported %lld rows, rejected %lld, success: %d",
+         static_cast<long long>(result.progress.rowsCommitted), static_cast<long long>(result.progress.rowsRejected), result.success);
+    return env->NewObject(g_csvImportResultDtoClass, g_csvImportResultDtoConstructor,
+                          result.success ? JNI_TRUE : JNI_FALSE,
+                          result.cancelled ? JNI_TRUE : JNI_FALSE,
+                          static_cast<jlong>(result.progress.rowsCommitted),
+                          static_cast<jlong>(result.progress.rowsRejected),
+                          static_cast<jlong>(result.firstRejectedLine));
+}
+
+extern "C" JNIEXPORT jlong JNICALL
+Java_com_example_pocketmoneyapp_TransactionListActivity_exportTransactionsNative(
+        JNIEnv* env, jobject /* this */, jint fd, jint walletId, jint format, jobject listener) {
+
+    if (s_connections == nullptr) {
+        LOGE("ConnectionManager not initialized. Call initializeNativeDb first.");
+        return -1;
+    }
+    if (format != static_cast<jint>(data::ExportFormat::CSV) && format != static_cast<jint>(data::ExportFormat::JSON_LINES)) {
+        LOGE("exportTransactionsNative: Unknown format %d.", static_cast<int>(format));
+        return -1;
+    }
+
+    jmethodID onProgress = nullptr;
+    if (listener != nullptr) {
+        jclass listenerClass = env->GetObjectClass(listener);
+        onProgress = env->GetMethodID(listenerClass, "onProgress", "(JJ)Z");
+        env->DeleteLocalRef(listenerClass);
+        if (onProgress == nullptr) {
+            LOGE("exportTransactionsNative: listener has no onProgress(JJ)Z.");
+            return -1;
+        }
+    }
+    data::ExportProgressCallback progress = [&](const data::ExportProgress& p) {
+        if (onProgress == nullptr) return true;
+        if (env->ExceptionCheck()) return false;
+        jboolean keepGoing = env->CallBooleanMethod(listener, onProgress,
+                                                    static_cast<jlong>(p.rowsWritten), static_cast<jlong>(p.bytesWritten));
+        return !env->ExceptionCheck() && keepGoing == JNI_TRUE;
+    };
+
+    data::ExportOptions options;
+    options.format = static_cast<data::ExportFormat>(format);
+    options.walletId = static_cast<int>(walletId);
+    // 읽기만 하므로 쓰기 스레드를 거치지 않는다. 전용 읽기 커넥션의 스냅샷에서 읽는다
+    data::TransactionExporter exporter(*s_connections, options);
+    data::ExportResult result = exporter.exportToFd(static_cast<int>(fd), progress);
+    if (env->ExceptionCheck()) {
+        return -1;
+    }
+
+    LOGD("exportTransactionsNative: Wrote %lld rows (%lld bytes), success: %d, cancelled: %d",
+         static_cast<long long>(result.progress.rowsWritten), static_cast<long long>(result.progress.bytesWritten),
+         result.success, result.cancelled);
+    return result.success ? static_cast<jlong>(result.progress.rowsWritten) : -1;
+}
+
 extern "C" JNIEXPORT jobjectArray JNICALL
 Java_com_example_pocketmoneyapp_TransactionListActivity_getTransactionsByWalletNative(
         JNIEnv* env, jobject /* this */, jint walletId) {
@@ -310,42 +736,148 @@ Java_com_example_pocketmoneyapp_TransactionListActivity_getTransactionsByWalletN
 
     std::vector<domain::Transaction> transactions = s_transactionRepo->getTransactionsByWalletId(static_cast<int>(walletId));
 
-    jclass transactionDtoClass = g_transactionDtoClass;
-    if (transactionDtoClass == nullptr) {
-        LOGE("Failed to get global ref for TransactionDto class in getTransactionsByWalletNative.");
+    jobjectArray transactionArray = newTransactionDtoArray(env, transactions);
+    if (transactionArray == nullptr) {
         return nullptr;
     }
-    jmethodID constructor = g_transactionDtoConstructor;
-    if (constructor == nullptr) {
-        LOGE("Failed to get global ref for TransactionDto constructor in getTransactionsByWalletNative.");
+    LOGD("getTransactionsByWalletNative: Retrieved %zu transactions for wallet ID %d.", transactions.size(), static_cast<int>(walletId));
+    return transactionArray;
+}
+
+extern "C" JNIEXPORT jobject JNICALL
+Java_com_example_pocketmoneyapp_TransactionListActivity_getTransactionsPageNative(
+        JNIEnv* env, jobject /* this */, jint walletId, jstring afterDateJString, jint afterId, jint limit) {
+
+    if (s_transactionRepo == nullptr) {
+        LOGE("TransactionRepository not initialized. Call initializeNativeDb first.");
+        return nullptr;
+    }
+    if (g_transactionPageDtoClass == nullptr || g_transactionPageDtoConstructor == nullptr) {
+        LOGE("Failed to get global ref for TransactionPageDto in getTransactionsPageNative.");
         return nullptr;
     }
 
-    jobjectArray transactionArray = env->NewObjectArray(transactions.size(), transactionDtoClass, nullptr);
+    // afterDate 가 null 이면 첫 페이지
+    int64_t afterDate = 0;
+    if (afterDateJString == nullptr) {
+        afterId = 0;
+    } else if (!readDateTime(env, afterDateJString, afterDate)) {
+        LOGE("getTransactionsPageNative: Invalid page cursor date.");
+        return nullptr;
+    }
+
+    data::TransactionPage page = s_transactionRepo->getTransactionsPage(
+            static_cast<int>(walletId), afterDate, static_cast<int>(afterId), static_cast<int>(limit), true);
+
+    jobjectArray transactionArray = newTransactionDtoArray(env, page.transactions);
     if (transactionArray == nullptr) {
-        LOGE("Failed to create new jobjectArray for transactions.");
         return nullptr;
     }
+    jstring nextDateJStr = page.transactions.empty() ? env->NewStringUTF("") : newDateTimeString(env, page.nextDate);
 
-    for (size_t i = 0; i < transactions.size(); ++i) {
-        jstring descriptionJStr = env->NewStringUTF(transactions[i].description.c_str());
-        jstring transactionDateJStr = env->NewStringUTF(transactions[i].transactionDate.c_str());
+    // 잔액 색인을 쓸 수 없으면 빈 배열
+    jlongArray runningBalanceArray = env->NewLongArray(static_cast<jsize>(page.runningBalances.size()));
+    if (runningBalanceArray == nullptr) {
+        LOGE("Failed to create running balance array.");
+        return nullptr;
+    }
+    static_assert(sizeof(jlong) == sizeof(long long), "jlong must match long long");
+    env->SetLongArrayRegion(runningBalanceArray, 0, static_cast<jsize>(page.runningBalances.size()),
+                            reinterpret_cast<const jlong*>(page.runningBalances.data()));
+
+    jobject pageDtoObj = env->NewObject(g_transactionPageDtoClass, g_transactionPageDtoConstructor,
+                                        transactionArray,
+                                        page.hasMore ? JNI_TRUE : JNI_FALSE,
+                                        nextDateJStr,
+                                        static_cast<jint>(page.nextId),
+                                        runningBalanceArray);
+
+    env->DeleteLocalRef(transactionArray);
+    env->DeleteLocalRef(nextDateJStr);
+    env->DeleteLocalRef(runningBalanceArray);
+
+    LOGD("getTransactionsPageNative: Retrieved %zu transactions for wallet ID %d, hasMore: %d", page.transactions.size(), static_cast<int>(walletId), page.hasMore);
+    return pageDtoObj;
+}
 
-        jobject transactionDtoObj = env->NewObject(transactionDtoClass, constructor,
-                                                   static_cast<jint>(transactions[i].id),
-                                                   static_cast<jint>(transactions[i].walletId),
-                                                   static_cast<jlong>(transactions[i].amount),
-                                                   descriptionJStr,
-                                                   static_cast<jint>(transactions[i].type),
-                                                   transactionDateJStr);
-        env->SetObjectArrayElement(transactionArray, i, transactionDtoObj);
+extern "C" JNIEXPORT jobject JNICALL
+Java_com_example_pocketmoneyapp_TransactionListActivity_searchTransactionsNative(
+        JNIEnv* env, jobject /* this */, jstring queryJString, jint walletId, jint limit, jdouble afterRank, jint afterId) {
 
-        env->DeleteLocalRef(descriptionJStr);
-        env->DeleteLocalRef(transactionDateJStr);
-        env->DeleteLocalRef(transactionDtoObj);
+    if (s_transactionRepo == nullptr) {
+        LOGE("TransactionRepository not initialized. Call initializeNativeDb first.");
+        return nullptr;
     }
-    LOGD("getTransactionsByWalletNative: Retrieved %zu transactions for wallet ID %d.", transactions.size(), static_cast<int>(walletId));
-    return transactionArray;
+    if (g_transactionSearchPageDtoClass == nullptr || g_transactionSearchPageDtoConstructor == nullptr) {
+        LOGE("Failed to get global ref for TransactionSearchPageDto in searchTransactionsNative.");
+        return nullptr;
+    }
+    if (queryJString == nullptr) {
+        LOGE("searchTransactionsNative: query is null.");
+        return nullptr;
+    }
+
+    const char* queryCStr = env->GetStringUTFChars(queryJString, nullptr);
+    if (queryCStr == nullptr) {
+        return nullptr;
+    }
+    std::string query(queryCStr);
+    env->ReleaseStringUTFChars(queryJString, queryCStr);
+
+    data::TransactionSearchPage page = s_transactionRepo->searchTransactions(
+            query, static_cast<int>(walletId), static_cast<int>(limit), static_cast<double>(afterRank), static_cast<int>(afterId));
+
+    jobjectArray transactionArray = newTransactionDtoArray(env, page.transactions);
+    if (transactionArray == nullptr) {
+        return nullptr;
+    }
+    jobject pageDtoObj = env->NewObject(g_transactionSearchPageDtoClass, g_transactionSearchPageDtoConstructor,
+                                        transactionArray,
+                                        page.hasMore ? JNI_TRUE : JNI_FALSE,
+                                        static_cast<jdouble>(page.nextRank),
+                                        static_cast<jint>(page.nextId));
+    env->DeleteLocalRef(transactionArray);
+
+    LOGD("searchTransactionsNative: Found %zu transactions, hasMore: %d", page.transactions.size(), page.hasMore);
+    return pageDtoObj;
+}
+
+extern "C" JNIEXPORT jint JNICALL
+Java_com_example_pocketmoneyapp_TransactionListActivity_getTransactionsColumnarNative(
+        JNIEnv* env, jobject /* this */, jint walletId, jlong afterDate, jint afterId, jint limit, jobject buffer) {
+
+    if (s_transactionRepo == nullptr) {
+        LOGE("TransactionRepository not initialized. Call initializeNativeDb first.");
+        return 0;
+    }
+
+    auto* address = static_cast<uint8_t*>(env->GetDirectBufferAddress(buffer));
+    jlong capacity = env->GetDirectBufferCapacity(buffer);
+    if (address == nullptr || capacity <= 0) {
+        LOGE("getTransactionsColumnarNative: buffer is not a direct ByteBuffer.");
+        return 0;
+    }
+
+    // afterId 가 0 이하이면 첫 페이지
+    data::ColumnarTransactionWriter writer(address, static_cast<size_t>(capacity), static_cast<int>(limit));
+    bool hasMore = false;
+    bool ok = s_transactionRepo->scanTransactionsPage(
+            static_cast<int>(walletId), static_cast<int64_t>(afterDate), static_cast<int>(afterId), static_cast<int>(limit),
+            [&writer](const data::TransactionRowView& row) {
+                writer.append(row);
+                return true; // 용량이 부족해도 끝까지 돌며 필요한 크기를 계산한다
+            }, hasMore);
+    if (!ok) {
+        return 0;
+    }
+
+    if (writer.overflowed()) {
+        LOGD("getTransactionsColumnarNative: buffer too small, %zu bytes required.", writer.requiredBytes());
+        return -static_cast<jint>(writer.requiredBytes());
+    }
+    size_t written = writer.finish(hasMore);
+    LOGD("getTransactionsColumnarNative: Wrote %d transactions (%zu bytes) for wallet ID %d.", writer.rowCount(), written, static_cast<int>(walletId));
+    return static_cast<jint>(written);
 }
 
 extern "C" JNIEXPORT jboolean JNICALL
@@ -356,27 +888,25 @@ Java_com_example_pocketmoneyapp_TransactionListActivity_updateTransactionNative(
         return JNI_FALSE;
     }
 
+    domain::Transaction transaction;
+    if (!readDateTime(env, transactionDateJString, transaction.transactionDate)) {
+        LOGE("updateTransactionNative: Invalid transaction date.");
+        return JNI_FALSE;
+    }
+
     const char* descriptionCStr = env->GetStringUTFChars(descriptionJString, nullptr);
-    const char* transactionDateCStr = env->GetStringUTFChars(transactionDateJString, nullptr);
 
-    domain::Transaction transaction;
     transaction.id = static_cast<int>(id);
     transaction.walletId = static_cast<int>(walletId);
     transaction.description = descriptionCStr;
     transaction.amount = static_cast<long long>(amount);
     transaction.type = static_cast<domain::TransactionType>(type);
-    transaction.transactionDate = transactionDateCStr;
 
     env->ReleaseStringUTFChars(descriptionJString, descriptionCStr);
-    env->ReleaseStringUTFChars(transactionDateJString, transactionDateCStr);
 
-    bool success = s_transactionRepo->updateTransaction(transaction);
+    bool success = runOnWriter([&] { return s_transactionRepo->updateTransaction(transaction); });
     LOGD("updateTransactionNative: Updated transaction ID %d for wallet ID %d, success: %d", transaction.id, transaction.walletId, success);
 
-    if (success && s_walletRepo != nullptr) {
-        s_walletRepo->recalculateBalance(transaction.walletId);
-        LOGD("updateTransactionNative: Recalculated balance for wallet ID %d", transaction.walletId);
-    }
     return success ? JNI_TRUE : JNI_FALSE;
 }
 
@@ -388,13 +918,9 @@ Java_com_example_pocketmoneyapp_TransactionListActivity_deleteTransactionNative(
         return JNI_FALSE;
     }
 
-    bool success = s_transactionRepo->deleteTransaction(static_cast<int>(id));
+    bool success = runOnWriter([&] { return s_transactionRepo->deleteTransaction(static_cast<int>(id)); });
     LOGD("deleteTransactionNative: Deleted transaction ID %d for wallet ID %d, success: %d", static_cast<int>(id), static_cast<int>(walletId), success);
 
-    if (success && s_walletRepo != nullptr) {
-        s_walletRepo->recalculateBalance(static_cast<int>(walletId));
-        LOGD("deleteTransactionNative: Recalculated balance for wallet ID %d", static_cast<int>(walletId));
-    }
     return success ? JNI_TRUE : JNI_FALSE;
 }
 
@@ -439,4 +965,225 @@ Java_com_example_pocketmoneyapp_TransactionListActivity_getWalletByIdNative(
 
     LOGD("getWalletByIdNative (TransactionListActivity): Found wallet ID %d: %s, balance %lld", wallet.id, wallet.name.c_str(), wallet.balance);
     return walletDtoObj;
-}
\ No newline at end of file
+}
+
+// 리포지토리 연산별 지연 분포 (count, p50/p95/p99/max ns). reset 이면 읽은 뒤 0 으로 비운다.
+extern "C" JNIEXPORT jobjectArray JNICALL
+Java_com_example_pocketmoneyapp_MainActivity_snapshotLatencyNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jboolean reset) {
+
+    std::vector<data::LatencyStats> stats = data::LatencyMetrics::snapshot(reset == JNI_TRUE);
+    jobjectArray result = env->NewObjectArray(static_cast<jsize>(stats.size()), g_latencyStatDtoClass, nullptr);
+    if (result == nullptr) {
+        LOGE("Failed to create LatencyStatDto array.");
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < stats.size(); ++i) {
+        const data::LatencyStats& entry = stats[i];
+        jstring jOperation = env->NewStringUTF(data::operationName(entry.operation));
+        jobject statObject = env->NewObject(g_latencyStatDtoClass, g_latencyStatDtoConstructor,
+                                            jOperation,
+                                            static_cast<jlong>(entry.count),
+                                            static_cast<jlong>(entry.p50Nanos),
+                                            static_cast<jlong>(entry.p95Nanos),
+                                            static_cast<jlong>(entry.p99Nanos),
+                                            static_cast<jlong>(entry.maxNanos));
+        env->SetObjectArrayElement(result, static_cast<jsize>(i), statObject);
+        env->DeleteLocalRef(jOperation);
+        env->DeleteLocalRef(statObject);
+    }
+    return result;
+}
+
+// 실행 시점 로그 레벨 (android.util.Log.DEBUG..ERROR). 컴파일 시점 최소 레벨보다 낮은 로그는 여전히 빠진다.
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pocketmoneyapp_MainActivity_setNativeLogLevelNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jint level) {
+    platform::setLogLevel(static_cast<int>(level));
+}
+
+// 느린 쿼리 기록 켜기/끄기. capacity 개의 가장 느린 실행 중 thresholdMicros 이상만 남긴다 (capacity 0 이면 끔).
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_pocketmoneyapp_MainActivity_setSlowQueryLogNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jint capacity,
+        jlong thresholdMicros) {
+    if (s_connections == nullptr) {
+        LOGE("Database not initialized for setSlowQueryLog.");
+        return JNI_FALSE;
+    }
+    size_t entries = capacity > 0 ? static_cast<size_t>(capacity) : 0;
+    int64_t thresholdNanos = thresholdMicros > 0 ? static_cast<int64_t>(thresholdMicros) * 1000 : 0;
+    return s_connections->setSlowQueryLog(entries, thresholdNanos) ? JNI_TRUE : JNI_FALSE;
+}
+
+// 지금까지 모인 느린 쿼리 (느린 순). reset 이면 비운다.
+extern "C" JNIEXPORT jobjectArray JNICALL
+Java_com_example_pocketmoneyapp_MainActivity_dumpSlowQueriesNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jboolean reset) {
+    std::vector<data::SlowQueryEntry> entries;
+    if (s_connections != nullptr) {
+        entries = s_connections->getSlowQueries(reset == JNI_TRUE);
+    }
+
+    jobjectArray result = env->NewObjectArray(static_cast<jsize>(entries.size()), g_slowQueryDtoClass, nullptr);
+    if (result == nullptr) {
+        LOGE("Failed to create SlowQueryDto array.");
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const data::SlowQueryEntry& entry = entries[i];
+        jstring jSql = env->NewStringUTF(entry.sql.c_str());
+        jobject queryObject = env->NewObject(g_slowQueryDtoClass, g_slowQueryDtoConstructor,
+                                             jSql,
+                                             static_cast<jlong>(entry.durationNanos),
+                                             static_cast<jlong>(entry.rows),
+                                             static_cast<jint>(entry.vmSteps),
+                                             static_cast<jint>(entry.fullScanSteps),
+                                             static_cast<jint>(entry.sorts));
+        env->SetObjectArrayElement(result, static_cast<jsize>(i), queryObject);
+        env->DeleteLocalRef(jSql);
+        env->DeleteLocalRef(queryObject);
+    }
+    return result;
+}
+
+// 지갑의 월별 합계 (yyyymm 오름차순). from/to 는 포함 범위이며 0 이면 제한 없음.
+extern "C" JNIEXPORT jobjectArray JNICALL
+Java_com_example_pocketmoneyapp_TransactionListActivity_getMonthlyTotalsNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jint walletId,
+        jint fromYyyymm,
+        jint toYyyymm) {
+    std::vector<data::MonthlyTotal> totals;
+    if (s_transactionRepo != nullptr) {
+        totals = s_transactionRepo->getMonthlyTotals(static_cast<int>(walletId), static_cast<int>(fromYyyymm),
+                                                     static_cast<int>(toYyyymm));
+    } else {
+        LOGE("TransactionRepository not initialized. Call initializeNativeDb first.");
+    }
+
+    jobjectArray result = env->NewObjectArray(static_cast<jsize>(totals.size()), g_monthlyTotalDtoClass, nullptr);
+    if (result == nullptr) {
+        LOGE("Failed to create MonthlyTotalDto array.");
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < totals.size(); ++i) {
+        const data::MonthlyTotal& total = totals[i];
+        jobject totalObject = env->NewObject(g_monthlyTotalDtoClass, g_monthlyTotalDtoConstructor,
+                                             static_cast<jint>(total.walletId),
+                                             static_cast<jint>(total.yyyymm),
+                                             static_cast<jlong>(total.income),
+                                             static_cast<jlong>(total.expense),
+                                             static_cast<jint>(total.count));
+        env->SetObjectArrayElement(result, static_cast<jsize>(i), totalObject);
+        env->DeleteLocalRef(totalObject);
+    }
+    return result;
+}
+
+// MonthlyTotals 를 거래 전체에서 다시 계산한다.
+// 쓰기 큐의 묶음 트랜잭션 안에서는 읽기 커넥션이 커밋 전 변경을 못 봐 병렬 집계를 쓸 수 없으므로,
+// 큐를 거치지 않고 호출 스레드에서 쓰기 잠금을 직접 잡는다 (진행 중인 묶음이 커밋된 뒤 시작).
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_pocketmoneyapp_MainActivity_rebuildMonthlyTotalsNative(
+        JNIEnv* env,
+        jobject /* this */) {
+    if (s_transactionRepo == nullptr) {
+        LOGE("TransactionRepository not initialized. Call initializeNativeDb first.");
+        return JNI_FALSE;
+    }
+    return s_transactionRepo->rebuildMonthlyTotals() ? JNI_TRUE : JNI_FALSE;
+}
+
+// date("YYYY-MM-DD HH:MM:SS") 시점까지의 지갑 잔액. 날짜가 잘못되었거나 오류면 Long.MIN_VALUE.
+extern "C" JNIEXPORT jlong JNICALL
+Java_com_example_pocketmoneyapp_TransactionListActivity_balanceAtNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jint walletId,
+        jstring dateJString) {
+    if (s_transactionRepo == nullptr) {
+        LOGE("TransactionRepository not initialized. Call initializeNativeDb first.");
+        return INT64_MIN;
+    }
+    int64_t date = 0;
+    if (!readDateTime(env, dateJString, date)) {
+        LOGE("balanceAtNative: Invalid date.");
+        return INT64_MIN;
+    }
+    long long balance = 0;
+    if (!s_transactionRepo->balanceAt(static_cast<int>(walletId), date, balance)) {
+        return INT64_MIN;
+    }
+    return static_cast<jlong>(balance);
+}
+
+// 지갑 캐시의 현재 세대. getAllWalletsNative 전에 읽어 두고 walletsChangedSinceNative 에 넘긴다 (0 이면 초기화 전).
+extern "C" JNIEXPORT jlong JNICALL
+Java_com_example_pocketmoneyapp_MainActivity_getWalletGenerationNative(
+        JNIEnv* env,
+        jobject /* this */) {
+    if (s_walletRepo == nullptr) {
+        LOGE("WalletRepository not initialized. Call initializeNativeDb first.");
+        return 0;
+    }
+    return static_cast<jlong>(s_walletRepo->getGeneration());
+}
+
+// generation 이후 지갑(이름, 잔액 포함)이 하나라도 바뀌었는지. SQLite 를 거치지 않는 원자 변수 비교다.
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_example_pocketmoneyapp_MainActivity_walletsChangedSinceNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jlong generation) {
+    if (s_walletRepo == nullptr) {
+        return JNI_TRUE;
+    }
+    return s_walletRepo->hasChangedSince(static_cast<uint64_t>(generation)) ? JNI_TRUE : JNI_FALSE;
+}
+
+// 거래 목록 페이지 캐시의 바이트 예산 (0 이면 캐시를 쓰지 않는다).
+extern "C" JNIEXPORT void JNICALL
+Java_com_example_pocketmoneyapp_MainActivity_setPageCacheBudgetNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jlong budgetBytes) {
+    if (s_transactionRepo == nullptr) {
+        LOGE("TransactionRepository not initialized. Call initializeNativeDb first.");
+        return;
+    }
+    s_transactionRepo->setPageCacheBudget(budgetBytes > 0 ? static_cast<size_t>(budgetBytes) : 0);
+}
+
+// 페이지 캐시 적중/실패/축출/무효화 횟수와 현재 크기. reset 이면 횟수를 0 으로 되돌린다.
+extern "C" JNIEXPORT jobject JNICALL
+Java_com_example_pocketmoneyapp_MainActivity_getPageCacheStatsNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jboolean reset) {
+    if (s_transactionRepo == nullptr) {
+        LOGE("TransactionRepository not initialized. Call initializeNativeDb first.");
+        return nullptr;
+    }
+    data::PageCacheStats stats = s_transactionRepo->getPageCacheStats(reset == JNI_TRUE);
+    return env->NewObject(g_pageCacheStatsDtoClass, g_pageCacheStatsDtoConstructor,
+                          static_cast<jlong>(stats.hits),
+                          static_cast<jlong>(stats.misses),
+                          static_cast<jlong>(stats.evictions),
+                          static_cast<jlong>(stats.invalidations),
+                          static_cast<jlong>(stats.bytes),
+                          static_cast<jint>(stats.entries),
+                          static_cast<jlong>(stats.budgetBytes));
+}
@@ -0,0 +1,92 @@
+//
+// Created by ss on 2025-08-07.
+//
+
+#ifndef POCKETMONEYAPP_LOG_H
+#define POCKETMONEYAPP_LOG_H
+
+// 안드로이드에서는 logcat 으로, 호스트(Linux) 빌드에서는 stderr 로 출력하는 로그 shim.
+//
+// 두 단계로 거른다.
+//  - 컴파일 시점: NATIVE_CORE_MIN_LOG_LEVEL 보다 낮은 레벨의 PLATFORM_LOGx 는 상수 조건으로 제거되어
+//    인자(toString() 등)도 평가되지 않는다. 기본값은 릴리스(NDEBUG) 에서 WARN, 디버그에서 DEBUG.
+//  - 실행 시점: 컴파일에 남은 레벨은 platform::setLogLevel 로 다시 거를 수 있다 (원자 변수 읽기 한 번).
+
+#include <atomic>
+
+#ifdef __ANDROID__
+
+#include <android/log.h>
+
+#define PLATFORM_LOG_DEBUG ANDROID_LOG_DEBUG
+#define PLATFORM_LOG_INFO ANDROID_LOG_INFO
+#define PLATFORM_LOG_WARN ANDROID_LOG_WARN
+#define PLATFORM_LOG_ERROR ANDROID_LOG_ERROR
+#define PLATFORM_LOG_PRINT(priority, tag, ...) __android_log_print(priority, tag, __VA_ARGS__)
+#define PLATFORM_DEFAULT_RUNTIME_LOG_LEVEL PLATFORM_LOG_DEBUG
+
+#else
+
+#include <cstdarg>
+#include <cstdio>
+
+#define PLATFORM_LOG_DEBUG 3
+#define PLATFORM_LOG_INFO 4
+#define PLATFORM_LOG_WARN 5
+#define PLATFORM_LOG_ERROR 6
+#define PLATFORM_LOG_PRINT(priority, tag, ...) platform::logPrint(priority, tag, __VA_ARGS__)
+// 벤치마크/프로파일링 출력을 어지럽히지 않도록 호스트에서는 실행 시점 기본값을 WARN 으로 둔다
+#define PLATFORM_DEFAULT_RUNTIME_LOG_LEVEL PLATFORM_LOG_WARN
+
+namespace platform {
+
+    __attribute__((format(printf, 3, 4)))
+    inline void logPrint(int priority, const char* tag, const char* format, ...) {
+        static const char letters[] = "??VDIWEF";
+        std::fprintf(stderr, "%c/%s: ", priority >= 0 && priority < 8 ? letters[priority] : '?', tag);
+        va_list args;
+        va_start(args, format);
+        std::vfprintf(stderr, format, args);
+        va_end(args);
+        std::fputc('\n', stderr);
+    }
+
+}
+
+#endif
+
+#ifndef NATIVE_CORE_MIN_LOG_LEVEL
+#ifdef NDEBUG
+#define NATIVE_CORE_MIN_LOG_LEVEL PLATFORM_LOG_WARN
+#else
+#define NATIVE_CORE_MIN_LOG_LEVEL PLATFORM_LOG_DEBUG
+#endif
+#endif
+
+namespace platform {
+
+    inline std::atomic<int> runtimeLogLevel{PLATFORM_DEFAULT_RUNTIME_LOG_LEVEL};
+
+    inline void setLogLevel(int priority) {
+        runtimeLogLevel.store(priority, std::memory_order_relaxed);
+    }
+
+    inline int getLogLevel() {
+        return runtimeLogLevel.load(std::memory_order_relaxed);
+    }
+
+}
+
+#define PLATFORM_LOG(priority, tag, ...)                                                        \
+    do {                                                                                        \
+        if ((priority) >= NATIVE_CORE_MIN_LOG_LEVEL && (priority) >= platform::getLogLevel()) { \
+            PLATFORM_LOG_PRINT(priority, tag, __VA_ARGS__);                                     \
+        }                                                                                       \
+    } while (0)
+
+#define PLATFORM_LOGD(tag, ...) PLATFORM_LOG(PLATFORM_LOG_DEBUG, tag, __VA_ARGS__)
+#define PLATFORM_LOGI(tag, ...) PLATFORM_LOG(PLATFORM_LOG_INFO, tag, __VA_ARGS__)
+#define PLATFORM_LOGW(tag, ...) PLATFORM_LOG(PLATFORM_LOG_WARN, tag, __VA_ARGS__)
+#define PLATFORM_LOGE(tag, ...) PLATFORM_LOG(PLATFORM_LOG_ERROR, tag, __VA_ARGS__)
+
+#endif //POCKETMONEYAPP_LOG_H
@@ -0,0 +1,357 @@
+//
+// Created by ss on 2025-08-12.
+//
+
+// CsvTransactionImporter 호스트 테스트. 고정된 CSV 입력으로 읽기 버퍼 경계에 걸친 행, 깨진 UTF-8,
+// 너무 긴 행, 헤더 별칭을 확인한다. 실패한 검사마다 한 줄씩 출력하고 하나라도 실패하면 1 로 끝난다.
+//
+//   native_core_csv_test [--dir=/tmp]
+
+#include "../data/ConnectionManager.h"
+#include "../data/CsvTransactionImporter.h"
+#include "../data/TransactionRepository.h"
+#include "../data/WalletRepository.h"
+#include "../domain/DateTime.h"
+#include "../platform/Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+    int g_failures = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            ++g_failures;                                                                  \
+        }                                                                                  \
+    } while (0)
+
+    const size_t CHUNK = 4096; // CsvImportOptions::readBufferBytes 의 하한. 경계 테스트는 이 크기로 읽는다
+
+    std::string g_dir = "/tmp";
+
+    void removeDatabase(const std::string& path) {
+        unlink(path.c_str());
+        unlink((path + "-wal").c_str());
+        unlink((path + "-shm").c_str());
+    }
+
+    // 테스트 하나가 쓰는 빈 DB 와 지갑 2개
+    struct Fixture {
+        std::string path;
+        data::ConnectionManager connections;
+        std::unique_ptr<data::WalletRepository> wallets;
+        std::unique_ptr<data::TransactionRepository> transactions;
+
+        explicit Fixture(const std::string& name)
+                : path(g_dir + "/native_core_csv_test_" + name + ".db"), connections(path, 1) {
+            removeDatabase(path);
+            if (!connections.open()) {
+                std::fprintf(stderr, "cannot open %s\n", path.c_str());
+                std::exit(1);
+            }
+            wallets = std::make_unique<data::WalletRepository>(connections);
+            transactions = std::make_unique<data::TransactionRepository>(connections);
+            wallets->createWallet(domain::Wallet(0, "지갑1", "", 0));
+            wallets->createWallet(domain::Wallet(0, "지갑2", "", 0));
+        }
+
+        ~Fixture() {
+            transactions.reset();
+            wallets.reset();
+            connections.close();
+            removeDatabase(path);
+        }
+
+        data::CsvImportResult import(const std::string& csv, const data::CsvImportOptions& options = data::CsvImportOptions()) {
+            std::string csvPath = path + ".csv";
+            FILE* file = std::fopen(csvPath.c_str(), "wb");
+            if (!file) return data::CsvImportResult();
+            std::fwrite(csv.data(), 1, csv.size(), file);
+            std::fclose(file);
+            data::CsvTransactionImporter importer(connections, *transactions, options);
+            data::CsvImportResult result = importer.importFile(csvPath);
+            unlink(csvPath.c_str());
+            return result;
+        }
+
+        // 날짜 오름차순 (같으면 ID 오름차순). 입력 순서와 비교하기 쉽게 뒤집는다
+        std::vector<domain::Transaction> list(int walletId) {
+            std::vector<domain::Transaction> rows = transactions->getTransactionsByWalletId(walletId);
+            std::reverse(rows.begin(), rows.end());
+            return rows;
+        }
+    };
+
+    data::CsvImportOptions boundaryOptions() {
+        data::CsvImportOptions options;
+        options.readBufferBytes = CHUNK;
+        options.batchRows = 16;
+        options.commitRows = 32;
+        return options;
+    }
+
+    std::string date(int day) {
+        char text[domain::DATE_TIME_LENGTH + 1];
+        domain::formatDateTime(1704067200 + static_cast<int64_t>(day) * 86400, text); // 2024-01-01 부터 하루씩
+        return text;
+    }
+
+    // csv 가 target 바이트가 되도록 설명 길이를 맞춘 행을 붙인다 (eol 포함)
+    void padTo(std::string& csv, size_t target, int day, const char* eol = "\n") {
+        std::string prefix = "1," + date(day) + ",";
+        std::string suffix = std::string(",100") + eol;
+        size_t fixed = csv.size() + prefix.size() + suffix.size();
+        csv += prefix + std::string(target > fixed ? target - fixed : 1, 'p') + suffix;
+    }
+
+    // 따옴표 안의 쉼표, "" 이스케이프, 줄바꿈, CRLF, 멀티바이트 문자가 CHUNK 경계의 모든 위치에 걸리도록
+    // 길이가 조금씩 다른 행을 여러 CHUNK 에 걸쳐 넣고, 모든 행이 바이트 그대로 들어왔는지 본다
+    void testChunkBoundaries() {
+        Fixture fixture("boundaries");
+        std::string csv = "wallet_id,date,description,amount\r\n";
+        std::vector<std::string> expected;
+        for (int i = 0; csv.size() < 6 * CHUNK; ++i) {
+            std::string description = "가계부 " + std::to_string(i) + ", \"인용\"\n둘째 줄 " + std::string(i % 37 + 1, 'x');
+            std::string quoted;
+            for (char c : description) {
+                quoted += c;
+                if (c == '"') quoted += '"';
+            }
+            csv += "1," + date(i) + ",\"" + quoted + "\"," + std::to_string(1000 + i) + "\r\n";
+            expected.push_back(description);
+        }
+        data::CsvImportResult result = fixture.import(csv, boundaryOptions());
+        CHECK(result.success);
+        CHECK(result.progress.rowsRejected == 0);
+        CHECK(result.progress.rowsCommitted == static_cast<int64_t>(expected.size()));
+        CHECK(result.progress.bytesRead == static_cast<int64_t>(csv.size()));
+
+        std::vector<domain::Transaction> rows = fixture.list(1);
+        CHECK(rows.size() == expected.size());
+        for (size_t i = 0; i < std::min(rows.size(), expected.size()); ++i) {
+            CHECK(rows[i].description == expected[i]);
+            CHECK(rows[i].amount == 1000 + static_cast<long long>(i));
+            CHECK(rows[i].type == domain::TransactionType::INCOME);
+        }
+    }
+
+    // 경계 바로 앞뒤에 놓은 구분자: CRLF 의 CR 과 LF, 닫는 따옴표와 그 뒤의 "", 쉼표
+    void testDelimiterOnBoundary() {
+        Fixture fixture("delimiters");
+        std::string csv = "wallet_id,date,description,amount\n";
+        padTo(csv, CHUNK + 1, 0, "\r\n"); // CR 이 첫 CHUNK 의 마지막 바이트, LF 가 다음 CHUNK 의 첫 바이트
+        csv += "1," + date(1) + ",crlf,-200\n";
+
+        std::string quoted = "1," + date(2) + ",\"a\"\"b\",300\n"; // 이스케이프한 따옴표 "" 가 경계에 걸친다
+        padTo(csv, 2 * CHUNK - (quoted.find("\"\"") + 1), 3);
+        csv += quoted;
+
+        std::string comma = "1," + date(4) + ",comma,400\n"; // 설명 앞 쉼표가 다음 CHUNK 의 첫 바이트
+        padTo(csv, 3 * CHUNK - (comma.find(",comma")), 5);
+        csv += comma;
+
+        data::CsvImportResult result = fixture.import(csv, boundaryOptions());
+        CHECK(result.success);
+        CHECK(result.progress.rowsRejected == 0);
+        CHECK(result.progress.rowsCommitted == 6);
+
+        std::vector<domain::Transaction> rows = fixture.list(1);
+        CHECK(rows.size() == 6);
+        if (rows.size() == 6) {
+            CHECK(rows[1].description == "crlf");
+            CHECK(rows[1].amount == 200);
+            CHECK(rows[1].type == domain::TransactionType::EXPENSE);
+            CHECK(rows[2].description == "a\"b");
+            CHECK(rows[4].description == "comma");
+            CHECK(rows[4].amount == 400);
+        }
+    }
+
+    // 파이프로 한 바이트씩 늦게 보내 BOM 과 첫 헤더가 여러 read() 에 나뉘어 들어오게 한다
+    void testSplitBom() {
+        Fixture fixture("bom");
+        std::string csv = "\xEF\xBB\xBF" "date,amount\n2024-03-01,-1500\n2024-03-02,2500\n";
+        int fds[2];
+        CHECK(pipe(fds) == 0);
+        std::thread writer([&] {
+            for (char c : csv) {
+                if (write(fds[1], &c, 1) != 1) break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+            close(fds[1]);
+        });
+        data::CsvImportOptions options;
+        options.walletId = 2;
+        data::CsvTransactionImporter importer(fixture.connections, *fixture.transactions, options);
+        data::CsvImportResult result = importer.importFd(fds[0]);
+        writer.join();
+        close(fds[0]);
+
+        CHECK(result.success);
+        CHECK(result.progress.totalBytes == -1);
+        CHECK(result.progress.rowsCommitted == 2);
+        CHECK(fixture.list(2).size() == 2);
+    }
+
+    // 깨진 UTF-8 설명은 그 행만 거부하고 나머지는 그대로 넣는다
+    void testMalformedUtf8() {
+        Fixture fixture("utf8");
+        const char* descriptions[] = {
+                "정상 한글",           // 3
+                "\xC3\x28",            // 4: 잘못된 연속 바이트
+                "\xC0\xAF",            // 5: 과잉 길이 인코딩 ('/')
+                "\xED\xA0\x80",        // 6: 서로게이트
+                "cp949 \xB0\xA1",      // 7: 변환하지 않은 CP949 ("가")
+                "끝이 잘림 \xE2\x82",  // 8: 문자 중간에서 끝남
+                "\xF4\x90\x80\x80",    // 9: U+10FFFF 초과
+                "이모지 \xF0\x9F\x92\xB0", // 10: 4바이트 문자
+        };
+        std::string csv = "date,description,amount\n";
+        csv += date(0) + ",첫 행,100\n"; // 2
+        for (size_t i = 0; i < sizeof(descriptions) / sizeof(descriptions[0]); ++i) {
+            csv += date(static_cast<int>(i) + 1) + "," + descriptions[i] + ",100\n";
+        }
+        data::CsvImportOptions options;
+        options.walletId = 1;
+        data::CsvImportResult result = fixture.import(csv, options);
+        CHECK(result.success);
+        CHECK(result.progress.rowsCommitted == 3);
+        CHECK(result.progress.rowsRejected == 6);
+        CHECK(result.firstRejectedLine == 4);
+
+        std::vector<domain::Transaction> rows = fixture.list(1);
+        CHECK(rows.size() == 3);
+        if (rows.size() == 3) {
+            CHECK(rows[0].description == "첫 행");
+            CHECK(rows[1].description == "정상 한글");
+            CHECK(rows[2].description == descriptions[7]);
+        }
+    }
+
+    // maxRecordBytes 를 넘는 행과 열이 너무 많은 행은 거부하고, 그 뒤의 행과 줄 번호는 어긋나지 않는다
+    void testOverlongRecords() {
+        Fixture fixture("overlong");
+        data::CsvImportOptions options = boundaryOptions();
+        options.maxRecordBytes = 1024;
+
+        std::string csv = "wallet_id,date,description,amount\n";
+        csv += "1," + date(0) + ",short,100\n";                                          // 2
+        csv += "1," + date(1) + "," + std::string(3 * CHUNK, 'L') + ",100\n";            // 3: 여러 CHUNK 에 걸친 긴 행
+        csv += "1," + date(2) + ",after,200\n";                                          // 4
+        csv += "1," + date(3) + ",\"" + std::string(600, 'q') + "\n" + std::string(600, 'q') + "\",300\n"; // 5-6: 따옴표 안 줄바꿈
+        csv += "1," + date(4) + ",exact," + std::string(1024 - 1 - domain::DATE_TIME_LENGTH - 5 - 3, '0') + "400\n"; // 7: 필드 합이 정확히 1024
+        std::string wide = "1," + date(5) + ",wide,500";
+        for (int i = 0; i < 300; ++i) wide += ",x";
+        csv += wide + "\n";                                                              // 8: 열 300개
+        csv += "1," + date(6) + ",last,600\n";                                           // 9
+
+        data::CsvImportResult result = fixture.import(csv, options);
+        CHECK(result.success);
+        CHECK(result.progress.rowsCommitted == 4);
+        CHECK(result.progress.rowsRejected == 3);
+        CHECK(result.firstRejectedLine == 3);
+
+        std::vector<domain::Transaction> rows = fixture.list(1);
+        CHECK(rows.size() == 4);
+        if (rows.size() == 4) {
+            CHECK(rows[0].description == "short");
+            CHECK(rows[1].description == "after");
+            CHECK(rows[2].description == "exact");
+            CHECK(rows[2].amount == 400);
+            CHECK(rows[3].description == "last");
+        }
+
+        // 거부된 행의 줄 번호: 따옴표 안 줄바꿈도 줄로 센다
+        Fixture lines("overlong_lines");
+        std::string multiline = "wallet_id,date,description,amount\n";
+        multiline += "1," + date(0) + ",\"one\ntwo\nthree\",100\n";                      // 2-4
+        multiline += "1," + date(1) + "," + std::string(2000, 'L') + ",100\n";           // 5
+        result = lines.import(multiline, options);
+        CHECK(result.progress.rowsCommitted == 1);
+        CHECK(result.firstRejectedLine == 5);
+    }
+
+    // 헤더 별칭 (대소문자, 한글, 공백) 과 필수 열이 없는 헤더
+    void testHeaderAliases() {
+        struct Case {
+            const char* name;
+            std::string csv;
+            int walletId;
+            bool success;
+            int64_t committed;
+        } cases[] = {
+                {"english", "Transaction_Date, MEMO ,Amount,Type,WalletId\n" + date(0) + ",메모,1200,expense,2\n", 0, true, 1},
+                {"korean", "거래일시,적요,금액,구분\n" + date(0) + ",점심,8000,지출\n" + date(1) + ",용돈,10000,수입\n", 2, true, 2},
+                {"korean_short", "날짜,내용,금액\n2024/05/01,버스,-1250\n2024.05.02 08:30,환급,300\n", 2, true, 2},
+                {"reordered", "amount,wallet_id,description,date\n500,2,순서,2024-06-01T12:00:00\n", 0, true, 1},
+                {"missing_amount", "date,description\n" + date(0) + ",x\n", 2, false, 0},
+                {"missing_wallet", "date,amount\n" + date(0) + ",100\n", 0, false, 0},
+                {"empty", "", 2, false, 0},
+        };
+        for (const Case& c : cases) {
+            Fixture fixture(std::string("header_") + c.name);
+            data::CsvImportOptions options;
+            options.walletId = c.walletId;
+            data::CsvImportResult result = fixture.import(c.csv, options);
+            if (result.success != c.success || result.progress.rowsCommitted != c.committed) {
+                std::fprintf(stderr, "header case %s: success %d committed %lld\n", c.name, result.success,
+                             static_cast<long long>(result.progress.rowsCommitted));
+            }
+            CHECK(result.success == c.success);
+            CHECK(result.progress.rowsCommitted == c.committed);
+            CHECK(static_cast<int64_t>(fixture.list(2).size()) == c.committed);
+        }
+
+        Fixture typed("header_typed");
+        data::CsvImportOptions options;
+        options.walletId = 2;
+        typed.import("날짜,내용,금액\n2024/05/01,버스,-1250\n2024.05.02 08:30,환급,300\n", options);
+        std::vector<domain::Transaction> rows = typed.list(2);
+        CHECK(rows.size() == 2);
+        if (rows.size() == 2) {
+            CHECK(rows[0].type == domain::TransactionType::EXPENSE && rows[0].amount == 1250);
+            CHECK(rows[1].type == domain::TransactionType::INCOME && rows[1].amount == 300);
+            int64_t expected = 0;
+            CHECK(domain::parseDateTime("2024-05-02 08:30:00", domain::DATE_TIME_LENGTH, expected));
+            CHECK(rows[1].transactionDate == expected);
+        }
+    }
+
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--dir=", 6) == 0) {
+            g_dir = argv[i] + 6;
+        } else {
+            std::fprintf(stderr, "usage: %s [--dir=/tmp]\n", argv[0]);
+            return 2;
+        }
+    }
+    platform::setLogLevel(6); // 거부된 행마다 남는 로그는 숨긴다
+
+    testChunkBoundaries();
+    testDelimiterOnBoundary();
+    testSplitBom();
+    testMalformedUtf8();
+    testOverlongRecords();
+    testHeaderAliases();
+
+    if (g_failures > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "all checks passed\n");
+    return 0;
+}
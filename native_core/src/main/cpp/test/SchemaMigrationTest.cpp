@@ -0,0 +1,328 @@
+//
+// Created by ss on 2025-08-12.
+//
+
+// 스키마 버전 2 (TEXT -> epoch 날짜) 백필 호스트 테스트. TEXT 날짜로 만든 옛 DB 를 열어 백필이 끝나기 전과
+// 끝난 뒤에 같은 조회 결과가 나오는지 본다. 실패한 검사마다 한 줄씩 출력하고 하나라도 실패하면 1 로 끝난다.
+//
+//   native_core_migration_test [--dir=/tmp]
+
+#include "../data/ConnectionManager.h"
+#include "../data/TransactionRepository.h"
+#include "../data/WalletRepository.h"
+#include "../domain/DateTime.h"
+#include "../platform/Log.h"
+
+#include <sqlite3.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    int g_failures = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            ++g_failures;                                                                  \
+        }                                                                                  \
+    } while (0)
+
+    // 첫 백필 호출(DEFAULT_CHUNK_ROWS)이 다 옮기지 못하도록 두 묶음 넘게 넣는다
+    const int LEGACY_ROWS = 2 * data::SchemaMigrator::DEFAULT_CHUNK_ROWS + 500;
+    const int64_t BASE_DATE = 1704067200; // 2024-01-01 00:00:00
+
+    std::string g_dir = "/tmp";
+
+    void removeDatabase(const std::string& path) {
+        unlink(path.c_str());
+        unlink((path + "-wal").c_str());
+        unlink((path + "-shm").c_str());
+    }
+
+    // ID 1 부터 지갑 1, 2 를 번갈아 쓰고, 지갑마다 두 거래씩 같은 날짜를 둔다
+    int walletOf(int id) { return id % 2 + 1; }
+    int64_t dateOf(int id) { return BASE_DATE + (id / 4) * 3600; }
+    long long signedAmountOf(int id) { return id % 3 == 0 ? id : -id; }
+
+    // 버전 1 이전 스키마: user_version 0, TransactionDate 는 'YYYY-MM-DD HH:MM:SS' TEXT. extraSql 은 행을 넣은 뒤 실행한다
+    bool createLegacyDatabase(const std::string& path, const char* extraSql) {
+        sqlite3* db = nullptr;
+        if (sqlite3_open(path.c_str(), &db) != SQLITE_OK) {
+            sqlite3_close(db);
+            return false;
+        }
+        bool ok = sqlite3_exec(db,
+                               "CREATE TABLE Wallets (ID INTEGER PRIMARY KEY AUTOINCREMENT, NAME TEXT NOT NULL UNIQUE, "
+                               "DESCRIPTION TEXT, BALANCE INTEGER DEFAULT 0);"
+                               "CREATE TABLE Transactions (ID INTEGER PRIMARY KEY AUTOINCREMENT, wallet_id INTEGER NOT NULL, "
+                               "Description TEXT, Amount INTEGER NOT NULL, Type INTEGER NOT NULL, TransactionDate TEXT NOT NULL, "
+                               "FOREIGN KEY(wallet_id) REFERENCES Wallets(ID) ON DELETE CASCADE);"
+                               "INSERT INTO Wallets (NAME) VALUES ('지갑1'), ('지갑2');"
+                               "BEGIN;", nullptr, nullptr, nullptr) == SQLITE_OK;
+        sqlite3_stmt* stmt = nullptr;
+        ok = ok && sqlite3_prepare_v2(db, "INSERT INTO Transactions (ID, wallet_id, Description, Amount, Type, TransactionDate) "
+                                          "VALUES (?, ?, ?, ?, ?, ?);", -1, &stmt, nullptr) == SQLITE_OK;
+        for (int id = 1; ok && id <= LEGACY_ROWS; ++id) {
+            char date[domain::DATE_TIME_LENGTH + 1];
+            domain::formatDateTime(dateOf(id), date);
+            std::string description = "옛 거래 " + std::to_string(id);
+            sqlite3_bind_int(stmt, 1, id);
+            sqlite3_bind_int(stmt, 2, walletOf(id));
+            sqlite3_bind_text(stmt, 3, description.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int64(stmt, 4, id);
+            sqlite3_bind_int(stmt, 5, id % 3 == 0 ? 0 : 1);
+            sqlite3_bind_text(stmt, 6, date, -1, SQLITE_TRANSIENT);
+            ok = sqlite3_step(stmt) == SQLITE_DONE;
+            sqlite3_reset(stmt);
+        }
+        sqlite3_finalize(stmt);
+        ok = ok && sqlite3_exec(db,
+                                "UPDATE Wallets SET BALANCE = (SELECT SUM(CASE Type WHEN 0 THEN Amount ELSE -Amount END) "
+                                "FROM Transactions WHERE wallet_id = Wallets.ID);"
+                                "COMMIT;", nullptr, nullptr, nullptr) == SQLITE_OK;
+        ok = ok && (!extraSql || sqlite3_exec(db, extraSql, nullptr, nullptr, nullptr) == SQLITE_OK);
+        sqlite3_close(db);
+        return ok;
+    }
+
+    // 시작 백필 예산 0: open() 은 한 묶음만 옮기고 나머지는 continueMigrations 에 남긴다
+    struct Fixture {
+        std::string path;
+        data::ConnectionManager connections;
+        std::unique_ptr<data::WalletRepository> wallets;
+        std::unique_ptr<data::TransactionRepository> transactions;
+
+        explicit Fixture(const std::string& name, const char* extraSql = nullptr)
+                : path(g_dir + "/native_core_migration_test_" + name + ".db"),
+                  connections(path, 1, data::OpenProfile(), std::chrono::milliseconds(0)) {
+            removeDatabase(path);
+            if (!createLegacyDatabase(path, extraSql) || !connections.open()) {
+                std::fprintf(stderr, "cannot open %s\n", path.c_str());
+                std::exit(1);
+            }
+            wallets = std::make_unique<data::WalletRepository>(connections);
+            transactions = std::make_unique<data::TransactionRepository>(connections);
+        }
+
+        ~Fixture() {
+            transactions.reset();
+            wallets.reset();
+            connections.close();
+            removeDatabase(path);
+        }
+
+        void finishMigrations() {
+            data::MigrationStatus status;
+            while ((status = connections.continueMigrations(std::chrono::milliseconds(0))) == data::MigrationStatus::PENDING) {
+            }
+            CHECK(status == data::MigrationStatus::COMPLETE);
+        }
+
+        // 첫 페이지부터 끝까지 넘기며 모은다
+        std::vector<domain::Transaction> pageThrough(int walletId, int limit, bool withRunningBalances) {
+            std::vector<domain::Transaction> rows;
+            data::TransactionPage page;
+            do {
+                page = transactions->getTransactionsPage(walletId, page.nextDate, page.nextId, limit, withRunningBalances);
+                if (withRunningBalances) {
+                    CHECK(page.runningBalances.size() == page.transactions.size());
+                }
+                rows.insert(rows.end(), page.transactions.begin(), page.transactions.end());
+            } while (page.hasMore && !page.transactions.empty());
+            return rows;
+        }
+    };
+
+    // 최신순 (날짜 내림차순, 같으면 ID 내림차순)
+    std::vector<int> expectedIds(int walletId) {
+        std::vector<int> ids;
+        for (int id = LEGACY_ROWS; id >= 1; --id) {
+            if (walletOf(id) == walletId) ids.push_back(id);
+        }
+        std::stable_sort(ids.begin(), ids.end(), [](int a, int b) { return dateOf(a) > dateOf(b); });
+        return ids;
+    }
+
+    bool matchesExpected(const std::vector<domain::Transaction>& rows, int walletId) {
+        std::vector<int> ids = expectedIds(walletId);
+        if (rows.size() != ids.size()) return false;
+        for (size_t i = 0; i < rows.size(); ++i) {
+            if (rows[i].id != ids[i] || rows[i].walletId != walletId || rows[i].transactionDate != dateOf(ids[i]) ||
+                rows[i].signedAmount() != signedAmountOf(ids[i])) {
+                std::fprintf(stderr, "row %zu: id %d date %lld (expected id %d date %lld)\n", i, rows[i].id,
+                             static_cast<long long>(rows[i].transactionDate), ids[i], static_cast<long long>(dateOf(ids[i])));
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 백필 도중에도 아직 Transactions_legacy 에 남은 옛 거래가 단건/목록/페이지 조회에 모두 보인다
+    void testReadsDuringBackfill() {
+        Fixture fixture("reads");
+        CHECK(fixture.connections.hasPendingMigrations());
+
+        domain::Transaction oldest = fixture.transactions->getTransactionById(1); // 가장 작은 ID 는 마지막 묶음에서 옮겨진다
+        CHECK(oldest.id == 1);
+        CHECK(oldest.transactionDate == dateOf(1));
+        CHECK(oldest.description == "옛 거래 1");
+
+        for (int walletId = 1; walletId <= 2; ++walletId) {
+            CHECK(matchesExpected(fixture.transactions->getTransactionsByWalletId(walletId), walletId));
+            CHECK(matchesExpected(fixture.transactions->getTransactionsByWallet(walletId, "TransactionDate DESC, ID DESC"), walletId));
+            CHECK(matchesExpected(fixture.pageThrough(walletId, 100, false), walletId));
+        }
+
+        // 첫 행의 누적 잔액은 지갑 잔액과 같다
+        data::TransactionPage page = fixture.transactions->getTransactionsPage(1, 0, 0, 50, true);
+        CHECK(!page.runningBalances.empty());
+        CHECK(!page.runningBalances.empty() && page.runningBalances.front() == fixture.wallets->getWalletById(1).balance);
+
+        fixture.finishMigrations();
+        for (int walletId = 1; walletId <= 2; ++walletId) {
+            CHECK(matchesExpected(fixture.transactions->getTransactionsByWalletId(walletId), walletId));
+            CHECK(matchesExpected(fixture.pageThrough(walletId, 100, false), walletId));
+        }
+    }
+
+    // 옛 테이블에 남은 거래도 수정/삭제할 수 있고, 백필이 끝난 뒤에도 그 결과가 유지된다
+    void testWritesDuringBackfill() {
+        Fixture fixture("writes");
+        CHECK(fixture.connections.hasPendingMigrations());
+
+        domain::Transaction edited = fixture.transactions->getTransactionById(2);
+        CHECK(edited.id == 2);
+        edited.description = "고친 거래";
+        edited.amount = 7000;
+        edited.type = domain::TransactionType::INCOME;
+        long long before = fixture.wallets->getWalletById(edited.walletId).balance;
+        CHECK(fixture.transactions->updateTransaction(edited));
+        CHECK(fixture.transactions->deleteTransaction(4));
+        CHECK(!fixture.transactions->deleteTransaction(4));
+        long long expected = before - signedAmountOf(2) + 7000 - signedAmountOf(4);
+        CHECK(fixture.wallets->getWalletById(edited.walletId).balance == expected);
+
+        fixture.finishMigrations();
+        domain::Transaction reread = fixture.transactions->getTransactionById(2);
+        CHECK(reread.description == "고친 거래");
+        CHECK(reread.amount == 7000);
+        CHECK(reread.transactionDate == dateOf(2));
+        CHECK(fixture.transactions->getTransactionById(4).id == 0);
+        CHECK(fixture.wallets->verifyBalance(edited.walletId));
+        CHECK(fixture.wallets->getWalletById(edited.walletId).balance == expected);
+    }
+
+    bool samePage(const data::TransactionPage& a, const data::TransactionPage& b) {
+        if (a.transactions.size() != b.transactions.size() || a.runningBalances != b.runningBalances ||
+            a.hasMore != b.hasMore || a.nextDate != b.nextDate || a.nextId != b.nextId) {
+            return false;
+        }
+        for (size_t i = 0; i < a.transactions.size(); ++i) {
+            if (a.transactions[i].id != b.transactions[i].id || a.transactions[i].transactionDate != b.transactions[i].transactionDate ||
+                a.transactions[i].description != b.transactions[i].description) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 백필은 SQL 로 행을 옮기므로 묶음이 커밋될 때마다 페이지 캐시를 비우고 다시 읽는다. 내용은 백필 전후가 같다
+    void testPageCacheAcrossBackfill() {
+        Fixture fixture("page_cache");
+        fixture.transactions->getPageCacheStats(true);
+        data::TransactionPage during = fixture.transactions->getTransactionsPage(1, 0, 0, 100, true);
+        data::TransactionPage cached = fixture.transactions->getTransactionsPage(1, 0, 0, 100, true);
+        data::PageCacheStats stats = fixture.transactions->getPageCacheStats(true);
+        CHECK(stats.misses == 1 && stats.hits == 1);
+        CHECK(samePage(during, cached));
+        CHECK(matchesExpected(fixture.pageThrough(1, 100, false), 1));
+
+        // 남은 묶음 중 하나만 진행한다
+        CHECK(fixture.connections.continueMigrations(std::chrono::milliseconds(0)) == data::MigrationStatus::PENDING);
+        fixture.transactions->getPageCacheStats(true);
+        data::TransactionPage next = fixture.transactions->getTransactionsPage(1, 0, 0, 100, true);
+        stats = fixture.transactions->getPageCacheStats(true);
+        CHECK(stats.misses == 1 && stats.hits == 0);
+        CHECK(stats.invalidations > 0);
+        CHECK(samePage(during, next));
+
+        fixture.finishMigrations();
+        data::TransactionPage after = fixture.transactions->getTransactionsPage(1, 0, 0, 100, true);
+        stats = fixture.transactions->getPageCacheStats(true);
+        CHECK(stats.misses == 1 && stats.hits == 0);
+        CHECK(samePage(during, after));
+        CHECK(matchesExpected(fixture.pageThrough(1, 100, false), 1));
+        CHECK(!after.runningBalances.empty() && after.runningBalances.front() == fixture.wallets->getWalletById(1).balance);
+    }
+
+    // 해석할 수 없는 옛 날짜는 0 으로 옮기되 원문을 TransactionDateRepairs 에 남긴다.
+    // 가장 큰 ID 는 open() 의 첫 묶음, 작은 ID 는 마지막 묶음, ID 3 은 그 전에 수정되며 옮겨진다
+    void testUnparsableDates() {
+        std::string sql = "UPDATE Transactions SET TransactionDate = 'garbage' WHERE ID = 10;"
+                          "UPDATE Transactions SET TransactionDate = '' WHERE ID = 3;"
+                          "UPDATE Transactions SET TransactionDate = '2024-13-45 99:00:00' WHERE ID = " + std::to_string(LEGACY_ROWS) + ";";
+        Fixture fixture("unparsable", sql.c_str());
+        CHECK(fixture.connections.hasPendingMigrations());
+        CHECK(fixture.transactions->getTransactionById(10).transactionDate == 0);
+
+        domain::Transaction edited = fixture.transactions->getTransactionById(3);
+        edited.description = "날짜 고침";
+        CHECK(fixture.transactions->updateTransaction(edited));
+        fixture.finishMigrations();
+
+        CHECK(fixture.transactions->getTransactionById(10).transactionDate == 0);
+        CHECK(fixture.transactions->getTransactionById(LEGACY_ROWS).transactionDate == 0);
+        CHECK(fixture.transactions->getTransactionById(11).transactionDate == dateOf(11));
+
+        std::vector<std::pair<int, std::string>> repairs;
+        sqlite3* db = nullptr;
+        CHECK(sqlite3_open_v2(fixture.path.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) == SQLITE_OK);
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(db, "SELECT ID, TransactionDate FROM TransactionDateRepairs ORDER BY ID;", -1, &stmt, nullptr) == SQLITE_OK) {
+            while (sqlite3_step(stmt) == SQLITE_ROW) {
+                repairs.emplace_back(sqlite3_column_int(stmt, 0), reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)));
+            }
+        }
+        sqlite3_finalize(stmt);
+        sqlite3_close(db);
+        CHECK(repairs.size() == 3);
+        if (repairs.size() == 3) {
+            CHECK(repairs[0] == std::make_pair(3, std::string("")));
+            CHECK(repairs[1] == std::make_pair(10, std::string("garbage")));
+            CHECK(repairs[2] == std::make_pair(LEGACY_ROWS, std::string("2024-13-45 99:00:00")));
+        }
+    }
+
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--dir=", 6) == 0) {
+            g_dir = argv[i] + 6;
+        } else {
+            std::fprintf(stderr, "usage: %s [--dir=/tmp]\n", argv[0]);
+            return 2;
+        }
+    }
+    platform::setLogLevel(6); // 조회마다 남는 디버그 로그는 숨긴다
+
+    testReadsDuringBackfill();
+    testWritesDuringBackfill();
+    testPageCacheAcrossBackfill();
+    testUnparsableDates();
+
+    if (g_failures > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,217 @@
+//
+// Created by ss on 2025-08-08.
+//
+
+#include "LedgerGenerator.h"
+#include "../data/MonthlyTotals.h"
+#include "../domain/DateTime.h"
+#include "../platform/Log.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#define LOG_TAG_GEN "LedgerGenerator"
+#define LOGD_GEN(...) PLATFORM_LOGD(LOG_TAG_GEN, __VA_ARGS__)
+#define LOGE_GEN(...) PLATFORM_LOGE(LOG_TAG_GEN, __VA_ARGS__)
+
+namespace tools {
+
+    namespace {
+
+        // std::*_distribution 은 표준 라이브러리마다 결과가 달라 재현성이 없으므로 mt19937_64 출력만 직접 변환한다
+        class DeterministicRandom {
+        public:
+            explicit DeterministicRandom(uint64_t seed) : engine(seed) {}
+
+            uint64_t next() { return engine(); }
+
+            double uniform01() { return (engine() >> 11) * (1.0 / 9007199254740992.0); } // [0, 1)
+
+            long long uniformRange(long long low, long long high) { // [low, high]
+                uint64_t span = static_cast<uint64_t>(high - low) + 1;
+                return low + static_cast<long long>(engine() % span);
+            }
+
+            double standardNormal() { // Box-Muller
+                double u1 = 1.0 - uniform01();
+                double u2 = uniform01();
+                return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+            }
+
+        private:
+            std::mt19937_64 engine;
+        };
+
+        long long drawAmount(DeterministicRandom& random, const LedgerConfig& config) {
+            long long amount;
+            if (config.amountDistribution == AmountDistribution::UNIFORM) {
+                amount = random.uniformRange(config.minAmount, config.maxAmount);
+            } else {
+                double value = std::exp(std::log(static_cast<double>(config.medianAmount)) +
+                                        config.amountSigma * random.standardNormal());
+                amount = static_cast<long long>(std::llround(value));
+            }
+            if (amount < config.minAmount) amount = config.minAmount;
+            if (amount > config.maxAmount) amount = config.maxAmount;
+            return amount;
+        }
+
+        bool validate(const LedgerConfig& config, int64_t& from, int64_t& to) {
+            if (config.wallets <= 0 || config.transactions < 0 || config.batchRows <= 0) {
+                LOGE_GEN("Invalid wallet/transaction/batch count.");
+                return false;
+            }
+            if (!domain::parseDateTime(config.fromDate.c_str(), config.fromDate.size(), from) ||
+                !domain::parseDateTime(config.toDate.c_str(), config.toDate.size(), to) || to < from) {
+                LOGE_GEN("Invalid date span: %s .. %s", config.fromDate.c_str(), config.toDate.c_str());
+                return false;
+            }
+            if (config.minAmount <= 0 || config.maxAmount < config.minAmount || config.medianAmount <= 0) {
+                LOGE_GEN("Invalid amount range.");
+                return false;
+            }
+            if (config.incomeRatio < 0.0 || config.incomeRatio > 1.0) {
+                LOGE_GEN("Income ratio must be within [0, 1].");
+                return false;
+            }
+            if (config.incomeVocabulary.empty() || config.expenseVocabulary.empty()) {
+                LOGE_GEN("Description vocabularies must not be empty.");
+                return false;
+            }
+            return true;
+        }
+
+        // cacheKiB 가 0 이면 SQLite 기본 크기. threads 는 CREATE INDEX 정렬에 쓰는 보조 스레드 수
+        void setLoadPragmas(data::DatabaseHelper& helper, int cacheKiB, int threads) {
+            std::string pragmas = "PRAGMA cache_size = -" + std::to_string(cacheKiB > 0 ? cacheKiB : 2000) + ";" +
+                                  "PRAGMA threads = " + std::to_string(threads) + ";";
+            sqlite3_exec(helper.getDb(), pragmas.c_str(), 0, 0, nullptr);
+        }
+
+        bool createWallets(data::DatabaseHelper& helper, const LedgerConfig& config, std::vector<int>& walletIds) {
+            data::ScopedTransaction tx(helper);
+            if (!tx.isActive()) return false;
+            sqlite3_stmt* stmt = helper.prepareCached("INSERT INTO Wallets (Name, Description, Balance) VALUES (?, ?, 0);");
+            if (!stmt) return false;
+            for (int i = 0; i < config.wallets; ++i) {
+                std::string name = "ledger-" + std::to_string(config.seed) + "-" + std::to_string(i + 1);
+                sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_text(stmt, 2, "synthetic", -1, SQLITE_STATIC);
+                if (sqlite3_step(stmt) != SQLITE_DONE) {
+                    LOGE_GEN("SQL error (wallet insert): %s", sqlite3_errmsg(helper.getDb()));
+                    helper.releaseStatement(stmt);
+                    return false;
+                }
+                walletIds.push_back(static_cast<int>(sqlite3_last_insert_rowid(helper.getDb())));
+                sqlite3_reset(stmt);
+            }
+            helper.releaseStatement(stmt);
+            return tx.commit();
+        }
+
+    }
+
+    bool generateLedger(data::DatabaseHelper& helper, const LedgerConfig& config, LedgerStats* stats) {
+        int64_t from = 0;
+        int64_t to = 0;
+        if (!helper.getDb() || !validate(config, from, to)) return false;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<int> walletIds;
+        if (!createWallets(helper, config, walletIds)) {
+            LOGE_GEN("Wallet creation failed.");
+            return false;
+        }
+        // 지갑과 잔액을 SQL 로 직접 넣으므로 캐시는 다음 조회에서 다시 읽게 한다
+        helper.getWalletCache().invalidate();
+
+        // 지갑이 많으면 인덱스 삽입 위치가 흩어져 캐시를 계속 놓친다. 적재 후 정렬 한 번으로 만드는 편이 빠르다.
+        // 검색 색인도 행마다 트리거로 넣으면 문장마다 세그먼트가 생겨 병합 비용이 커지므로 끝난 뒤 한 번에 만든다
+        if (config.rebuildListIndex &&
+            (!helper.execute("DROP INDEX IF EXISTS idx_transactions_wallet_date;") || !helper.dropSearchIndex())) {
+            return false;
+        }
+        setLoadPragmas(helper, config.loadCacheKiB, 4);
+
+        DeterministicRandom random(config.seed);
+        std::vector<long long> balances(walletIds.size(), 0);
+        data::MonthlyTotalsAccumulator monthlyTotals;
+        int64_t span = to - from + 1;
+        long long written = 0;
+
+        sqlite3_stmt* stmt = helper.prepareCached(
+                "INSERT INTO Transactions (wallet_id, Description, Amount, Type, TransactionDate) VALUES (?, ?, ?, ?, ?);");
+        if (!stmt) return false;
+
+        while (written < config.transactions) {
+            long long batchEnd = std::min(config.transactions, written + config.batchRows);
+            data::ScopedTransaction tx(helper);
+            if (!tx.isActive()) {
+                helper.releaseStatement(stmt);
+                return false;
+            }
+            for (; written < batchEnd; ++written) {
+                size_t wallet = static_cast<size_t>(random.next() % walletIds.size());
+                bool income = random.uniform01() < config.incomeRatio;
+                const std::vector<std::string>& vocabulary = income ? config.incomeVocabulary : config.expenseVocabulary;
+                const std::string& description = vocabulary[random.next() % vocabulary.size()];
+                long long amount = drawAmount(random, config);
+                // 층화 추출: i 번째 거래는 구간의 i 번째 칸 안 임의 시각. 날짜가 시간순으로 쌓여 인덱스 삽입이 국소적이다
+                int64_t slotStart = from + static_cast<int64_t>(static_cast<double>(span) * written / config.transactions);
+                int64_t slotEnd = from + static_cast<int64_t>(static_cast<double>(span) * (written + 1) / config.transactions);
+                int64_t date = random.uniformRange(slotStart, std::max(slotStart, slotEnd - 1));
+
+                sqlite3_bind_int(stmt, 1, walletIds[wallet]);
+                sqlite3_bind_text(stmt, 2, description.c_str(), static_cast<int>(description.size()), SQLITE_STATIC);
+                sqlite3_bind_int64(stmt, 3, amount);
+                sqlite3_bind_int(stmt, 4, income ? 0 : 1);
+                sqlite3_bind_int64(stmt, 5, date);
+                if (sqlite3_step(stmt) != SQLITE_DONE) {
+                    LOGE_GEN("SQL error (transaction insert): %s", sqlite3_errmsg(helper.getDb()));
+                    helper.releaseStatement(stmt);
+                    return false;
+                }
+                sqlite3_reset(stmt);
+                balances[wallet] += income ? amount : -amount;
+                monthlyTotals.add(walletIds[wallet], date, income ? 0 : 1, amount);
+            }
+            if (!tx.commit()) {
+                helper.releaseStatement(stmt);
+                return false;
+            }
+        }
+        helper.releaseStatement(stmt);
+
+        bool indexed = !config.rebuildListIndex || (helper.createListIndex() && helper.rebuildSearchIndex());
+        setLoadPragmas(helper, helper.getProfile().cacheSizeKiB, 0);
+        if (!indexed) return false;
+
+        data::ScopedTransaction tx(helper);
+        stmt = helper.prepareCached("UPDATE Wallets SET BALANCE = BALANCE + ? WHERE ID = ?;");
+        if (!tx.isActive() || !stmt) return false;
+        for (size_t i = 0; i < walletIds.size(); ++i) {
+            sqlite3_bind_int64(stmt, 1, balances[i]);
+            sqlite3_bind_int(stmt, 2, walletIds[i]);
+            if (sqlite3_step(stmt) != SQLITE_DONE) {
+                helper.releaseStatement(stmt);
+                return false;
+            }
+            sqlite3_reset(stmt);
+        }
+        helper.releaseStatement(stmt);
+        if (!data::applyMonthlyTotals(helper, monthlyTotals) || !tx.commit()) return false;
+        helper.getWalletCache().invalidate();
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        LOGD_GEN("Generated %d wallets and %lld transactions in %.2f s.", config.wallets, config.transactions, seconds);
+        if (stats) {
+            stats->walletsCreated = static_cast<int>(walletIds.size());
+            stats->transactionsCreated = written;
+            stats->firstWalletId = walletIds.empty() ? 0 : walletIds.front();
+            stats->seconds = seconds;
+        }
+        return true;
+    }
+
+}
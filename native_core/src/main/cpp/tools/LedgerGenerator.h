@@ -0,0 +1,57 @@
+//
+// Created by ss on 2025-08-08.
+//
+
+#ifndef POCKETMONEYAPP_LEDGERGENERATOR_H
+#define POCKETMONEYAPP_LEDGERGENERATOR_H
+
+#include "../data/DatabaseHelper.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tools {
+
+    enum class AmountDistribution {
+        UNIFORM,    // [minAmount, maxAmount] 균등
+        LOG_NORMAL  // 작은 금액이 많고 큰 금액이 드문 분포. median 근처에 몰리고 [minAmount, maxAmount] 로 자른다
+    };
+
+    // 합성 가계부 설정. 같은 seed 와 설정이면 플랫폼과 관계없이 같은 데이터가 만들어진다.
+    struct LedgerConfig {
+        int wallets = 10;
+        long long transactions = 100000;
+        uint64_t seed = 42;
+
+        std::string fromDate = "2023-01-01 00:00:00";
+        std::string toDate = "2024-12-31 23:59:59";
+
+        AmountDistribution amountDistribution = AmountDistribution::LOG_NORMAL;
+        long long minAmount = 100;
+        long long maxAmount = 1000000;
+        long long medianAmount = 8000; // LOG_NORMAL 의 중앙값
+        double amountSigma = 1.0;      // LOG_NORMAL 의 ln 표준편차
+
+        double incomeRatio = 0.2; // 수입 거래 비율 (0..1)
+
+        std::vector<std::string> incomeVocabulary{"용돈", "월급", "아르바이트", "이자", "환급"};
+        std::vector<std::string> expenseVocabulary{"식비", "교통비", "간식", "카페", "문구", "도서", "게임", "통신비", "선물", "영화"};
+
+        int batchRows = 100000; // 한 SQLite 트랜잭션에 넣는 행 수
+        bool rebuildListIndex = true; // 적재 중에는 목록 인덱스와 검색 색인을 내렸다가 끝난 뒤 한 번에 만든다
+        int loadCacheKiB = 256 * 1024; // 적재 중에만 쓰는 page cache 크기
+    };
+
+    struct LedgerStats {
+        int walletsCreated = 0;
+        long long transactionsCreated = 0;
+        int firstWalletId = 0;
+        double seconds = 0;
+    };
+
+    // createTables 로 만든 Wallets/Transactions 에 바로 쓴다. 잔액과 MonthlyTotals 는 메모리에서 누적해 마지막에 한 번 기록한다.
+    bool generateLedger(data::DatabaseHelper& helper, const LedgerConfig& config, LedgerStats* stats = nullptr);
+
+}
+
+#endif //POCKETMONEYAPP_LEDGERGENERATOR_H